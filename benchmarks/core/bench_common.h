@@ -0,0 +1,182 @@
+#pragma once
+// Shared helpers for the portable benchmark executables: wall clock, cycle
+// counter, host description and a reproducible key generator.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#include <sys/utsname.h>
+#endif
+
+#if defined(__x86_64__) && !defined(_MSC_VER)
+#include <x86intrin.h>
+#include <cpuid.h>
+#endif
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+static inline double bench_time_ns(void) {
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency = {0};
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1e9 / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+// Reference-cycle counter: RDTSCP on x86_64 (waits for earlier instructions
+// to retire), CNTVCT_EL0 on AArch64. Both tick at a fixed rate independent
+// of turbo, so "cycles" here are reference cycles. Returns 0 elsewhere.
+static inline uint64_t bench_cycles(void) {
+#if defined(_M_X64) || defined(__x86_64__)
+    unsigned int aux;
+    return __rdtscp(&aux);
+#elif defined(__aarch64__)
+    uint64_t v;
+    __asm__ volatile("isb; mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return 0;
+#endif
+}
+
+static inline const char* bench_arch(void) {
+#if defined(_M_X64) || defined(__x86_64__)
+    return "x86_64";
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    return "arm64";
+#else
+    return "unknown";
+#endif
+}
+
+static inline const char* bench_os(void) {
+#if defined(_WIN32)
+    return "windows";
+#elif defined(__APPLE__)
+    return "macos";
+#elif defined(__linux__)
+    return "linux";
+#else
+    return "unix";
+#endif
+}
+
+static inline int bench_cpu_count(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+// Fills buf with the CPU model: CPUID brand string on x86_64, then
+// /proc/cpuinfo or sysctl, else "unknown".
+static inline void bench_cpu_model(char* buf, size_t len) {
+    snprintf(buf, len, "unknown");
+#if defined(_M_X64) || defined(__x86_64__)
+    unsigned int regs[12];
+    unsigned int max_ext;
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0x80000000);
+    max_ext = (unsigned int)r[0];
+    if (max_ext >= 0x80000004) {
+        for (int i = 0; i < 3; i++) {
+            __cpuid(r, 0x80000002 + i);
+            memcpy(regs + i * 4, r, sizeof(r));
+        }
+    }
+#else
+    unsigned int a, b, c, d;
+    __cpuid(0x80000000, a, b, c, d);
+    max_ext = a;
+    if (max_ext >= 0x80000004) {
+        for (unsigned int i = 0; i < 3; i++) {
+            __cpuid(0x80000002 + i, regs[i * 4], regs[i * 4 + 1], regs[i * 4 + 2], regs[i * 4 + 3]);
+        }
+    }
+#endif
+    if (max_ext >= 0x80000004) {
+        char brand[49];
+        memcpy(brand, regs, 48);
+        brand[48] = '\0';
+        const char* p = brand;
+        while (*p == ' ') p++;
+        snprintf(buf, len, "%s", p);
+        return;
+    }
+#endif
+#if defined(__linux__)
+    FILE* f = fopen("/proc/cpuinfo", "r");
+    if (f) {
+        char line[256];
+        while (fgets(line, sizeof(line), f)) {
+            // x86 "model name", arm64 "Hardware"/"CPU part" as a fallback
+            if (strncmp(line, "model name", 10) == 0 || strncmp(line, "Hardware", 8) == 0) {
+                char* colon = strchr(line, ':');
+                if (colon) {
+                    colon++;
+                    while (*colon == ' ' || *colon == '\t') colon++;
+                    colon[strcspn(colon, "\n")] = '\0';
+                    snprintf(buf, len, "%s", colon);
+                    break;
+                }
+            }
+        }
+        fclose(f);
+    }
+#elif defined(__APPLE__)
+    size_t size = len;
+    if (sysctlbyname("machdep.cpu.brand_string", buf, &size, NULL, 0) != 0) {
+        snprintf(buf, len, "unknown");
+    }
+#endif
+}
+
+// xorshift64: rand() is only 15 bits on Windows, too few for 10M elements
+static inline uint64_t bench_random(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static inline void* bench_aligned_alloc(size_t bytes) {
+#if defined(_WIN32)
+    return _aligned_malloc(bytes, 64);
+#else
+    void* p = NULL;
+    return posix_memalign(&p, 64, bytes) == 0 ? p : NULL;
+#endif
+}
+
+static inline void bench_aligned_free(void* p) {
+#if defined(_WIN32)
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
@@ -0,0 +1,107 @@
+#pragma once
+// Optional hardware performance counters for the benchmark harness, read
+// with perf_event_open on Linux. Each counter is opened on its own (not as a
+// group) so a PMU with few slots multiplexes them instead of refusing the
+// set; readings are scaled by time_enabled / time_running. Counters the
+// kernel or PMU refuses read as NAN. Other platforms report no counters.
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define BENCH_PERF_COUNTERS 6
+
+static const char* const bench_perf_names[BENCH_PERF_COUNTERS] = {
+    "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses", "dtlb_misses"
+};
+
+typedef struct bench_perf_t {
+    int fd[BENCH_PERF_COUNTERS];
+    int opened;
+} bench_perf_t;
+
+#if defined(__linux__)
+#define BENCH_PERF_CACHE(cache, op, result) \
+    ((cache) | ((op) << 8) | ((result) << 16))
+
+static inline int bench_perf_open_one(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+// Returns the number of counters that could be opened.
+static inline int bench_perf_open(bench_perf_t* p) {
+    p->opened = 0;
+    for (int i = 0; i < BENCH_PERF_COUNTERS; i++) p->fd[i] = -1;
+#if defined(__linux__)
+    const struct { uint32_t type; uint64_t config; } events[BENCH_PERF_COUNTERS] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, BENCH_PERF_CACHE(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        {PERF_TYPE_HW_CACHE, BENCH_PERF_CACHE(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        {PERF_TYPE_HW_CACHE, BENCH_PERF_CACHE(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    };
+    for (int i = 0; i < BENCH_PERF_COUNTERS; i++) {
+        p->fd[i] = bench_perf_open_one(events[i].type, events[i].config);
+        if (p->fd[i] >= 0) p->opened++;
+    }
+#endif
+    return p->opened;
+}
+
+static inline void bench_perf_start(bench_perf_t* p) {
+#if defined(__linux__)
+    for (int i = 0; i < BENCH_PERF_COUNTERS; i++) {
+        if (p->fd[i] < 0) continue;
+        ioctl(p->fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(p->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    (void)p;
+#endif
+}
+
+// Stops the counters and stores each count (multiplex-scaled) in values.
+static inline void bench_perf_stop(bench_perf_t* p, double values[BENCH_PERF_COUNTERS]) {
+    for (int i = 0; i < BENCH_PERF_COUNTERS; i++) values[i] = NAN;
+#if defined(__linux__)
+    for (int i = 0; i < BENCH_PERF_COUNTERS; i++) {
+        if (p->fd[i] >= 0) ioctl(p->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < BENCH_PERF_COUNTERS; i++) {
+        uint64_t data[3];  // value, time_enabled, time_running
+        if (p->fd[i] < 0 || read(p->fd[i], data, sizeof(data)) != (ssize_t)sizeof(data)) continue;
+        if (data[2] == 0) continue;
+        values[i] = (double)data[0] * ((double)data[1] / (double)data[2]);
+    }
+#else
+    (void)p;
+#endif
+}
+
+static inline void bench_perf_close(bench_perf_t* p) {
+#if defined(__linux__)
+    for (int i = 0; i < BENCH_PERF_COUNTERS; i++) {
+        if (p->fd[i] >= 0) close(p->fd[i]);
+        p->fd[i] = -1;
+    }
+#endif
+    p->opened = 0;
+}
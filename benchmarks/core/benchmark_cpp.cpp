@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "speedup/api.h"
+#include "speedup/speedup.hpp"
+#include "bench_common.h"
+
+// Header-only C++ API against the C ABI on the same keys. Each pair runs
+// the same kernel family: per-key speedup_binary_search_i64 /
+// speedup_binary_search_i64_avx2 calls vs sorted_view::find inlined into the
+// loop, the C batch vs find_batch, and the C indexes vs speedup::index. Keys
+// have random gaps (so the uniform-key interpolation path stays out). Build
+// with -mavx2 (or -march=native) to let the inlined kernel use the AVX2
+// finish too.
+// Usage: speedup_benchmark_cpp [lookups]  (default 1000000)
+
+template <class F>
+static double time_loop(std::int64_t lookups, F&& body) {
+    double start = bench_time_ns();
+    for (std::int64_t i = 0; i < lookups; i++) body(i);
+    return (bench_time_ns() - start) / (double)lookups;
+}
+
+int main(int argc, char** argv) {
+    std::int64_t lookups = 1000000;
+    if (argc > 1) lookups = std::strtoll(argv[1], NULL, 10);
+    if (lookups < 1000) lookups = 1000;
+    const std::int64_t sizes[] = {1000, 10000, 100000, 1000000, 10000000};
+
+    speedup_init();
+
+    std::printf("C++ Header-Only API vs C ABI\n");
+    std::printf("============================\n");
+    std::printf("Lookups: %lld, AVX2 inlined: %s\n", (long long)lookups,
+#if defined(__AVX2__)
+                "yes"
+#else
+                "no"
+#endif
+    );
+
+    FILE* csv = std::fopen("results_cpp.csv", "w");
+    if (csv) {
+        std::fprintf(csv, "Size,C search ns,C avx2 ns,C++ find ns,C batch ns,C++ find_batch ns,"
+                          "C eytzinger ns,C++ eytzinger ns,C stree ns,C++ stree ns\n");
+    }
+
+    std::printf("\n%10s %9s %9s %9s %9s %9s %9s %9s %9s %9s\n", "Size", "C search", "C avx2", "C++ find", "C batch",
+                "C++ batch", "C eytz", "C++ eytz", "C stree", "C++ stree");
+    std::printf("-----------------------------------------------------------------------------------------------\n");
+
+    std::vector<std::int64_t> keys((std::size_t)lookups);
+    std::vector<std::int64_t> out((std::size_t)lookups);
+    std::int64_t sink = 0;
+    for (std::int64_t size : sizes) {
+        std::vector<std::int64_t> array((std::size_t)size);
+        std::uint64_t rng = 12345;
+        std::int64_t v = 0;
+        for (std::int64_t i = 0; i < size; i++) {
+            v += 1 + (std::int64_t)(bench_random(&rng) % 8);
+            array[(std::size_t)i] = v;
+        }
+        for (std::int64_t i = 0; i < lookups; i++) keys[(std::size_t)i] = (std::int64_t)(bench_random(&rng) % (std::uint64_t)(v + 1));
+        const std::int64_t* a = array.data();
+        const std::int64_t* k = keys.data();
+
+        speedup::sorted_view<std::int64_t> view(a, (std::size_t)size);
+        double c_search = time_loop(lookups, [&](std::int64_t i) { sink += speedup_binary_search_i64(a, k[i], size); });
+        double c_avx2 = time_loop(lookups, [&](std::int64_t i) { sink += speedup_binary_search_i64_avx2(a, k[i], size); });
+        double cpp_find = time_loop(lookups, [&](std::int64_t i) { sink += view.find(k[i]); });
+
+        double start = bench_time_ns();
+        speedup_binary_search_i64_batch_interleaved(a, size, k, lookups, out.data());
+        double c_batch = (bench_time_ns() - start) / (double)lookups;
+        start = bench_time_ns();
+        view.find_batch(k, (std::size_t)lookups, out.data());
+        double cpp_batch = (bench_time_ns() - start) / (double)lookups;
+
+        speedup_index_i64_t* c_eytzinger = speedup_index_i64_build_eytzinger(a, size);
+        speedup_index_i64_t* c_stree = speedup_index_i64_build_stree(a, size);
+        if (!c_eytzinger || !c_stree) {
+            std::fprintf(stderr, "Index build failed\n");
+            return 1;
+        }
+        speedup::index<std::int64_t, speedup::layout::eytzinger> eytzinger(view);
+        speedup::index<std::int64_t, speedup::layout::stree> stree(view);
+        double c_eytz = time_loop(lookups, [&](std::int64_t i) { sink += speedup_index_i64_find(c_eytzinger, k[i]); });
+        double cpp_eytz = time_loop(lookups, [&](std::int64_t i) { sink += eytzinger.find(k[i]); });
+        double c_st = time_loop(lookups, [&](std::int64_t i) { sink += speedup_index_i64_find(c_stree, k[i]); });
+        double cpp_st = time_loop(lookups, [&](std::int64_t i) { sink += stree.find(k[i]); });
+        speedup_index_i64_free(c_eytzinger);
+        speedup_index_i64_free(c_stree);
+
+        std::printf("%10lld %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n", (long long)size, c_search, c_avx2,
+                    cpp_find, c_batch, cpp_batch, c_eytz, cpp_eytz, c_st, cpp_st);
+        if (csv) {
+            std::fprintf(csv, "%lld,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n", (long long)size, c_search, c_avx2,
+                         cpp_find, c_batch, cpp_batch, c_eytz, cpp_eytz, c_st, cpp_st);
+        }
+    }
+
+    if (csv) std::fclose(csv);
+    // Keeps every timed result live.
+    volatile std::int64_t keep = sink + out[0];
+    (void)keep;
+    return 0;
+}
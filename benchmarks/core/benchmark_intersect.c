@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "speedup/api.h"
+#include "bench_common.h"
+
+// Sorted-set intersection across size ratios. A fixed large array is
+// intersected with smaller sorted arrays from 1:1 to 1:10000, comparing a
+// loop of speedup_binary_search_i64 over the small side (what callers wrote
+// before the intersect API), the forced merge and batched-search strategies, and
+// the adaptive speedup_intersect_i64_count.
+// Usage: speedup_benchmark_intersect [large_size]  (default 10000000)
+
+typedef int64_t (*count_fn)(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size);
+
+static int64_t count_search_loop(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size) {
+    int64_t n = 0;
+    for (int64_t i = 0; i < a_size; i++) n += speedup_binary_search_i64(b, a[i], b_size) >= 0;
+    return n;
+}
+
+// Best of several runs, each repeating the call until it covers ~20 ms.
+static double time_ns(count_fn fn, const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size, int64_t* result) {
+    double best = 0;
+    for (int run = 0; run < 5; run++) {
+        int reps = 0;
+        double start = bench_time_ns();
+        double elapsed;
+        do {
+            *result = fn(a, a_size, b, b_size);
+            reps++;
+            elapsed = bench_time_ns() - start;
+        } while (elapsed < 2e7);
+        elapsed /= reps;
+        if (run == 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    int64_t large_size = 10000000;
+    if (argc > 1) large_size = strtoll(argv[1], NULL, 10);
+    if (large_size < 10000) large_size = 10000;
+    const int64_t ratios[] = {1, 4, 16, 64, 128, 256, 1000, 10000};
+    const char* names[] = {"search_loop", "merge", "search", "adaptive"};
+    count_fn fns[] = {count_search_loop, speedup_intersect_i64_count_merge,
+                      speedup_intersect_i64_count_search, speedup_intersect_i64_count};
+
+    speedup_init();
+
+    printf("Sorted-Set Intersection\n");
+    printf("=======================\n");
+    printf("Large array: %lld elements (%.2f MB), batched search above ratio %d\n",
+           (long long)large_size, large_size * sizeof(int64_t) / (1024.0 * 1024.0), SPEEDUP_INTERSECT_SEARCH_RATIO);
+
+    int64_t* large = (int64_t*)malloc(large_size * sizeof(int64_t));
+    int64_t* small = (int64_t*)malloc(large_size * sizeof(int64_t));
+    if (!large || !small) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return 1;
+    }
+
+    // Gaps of 1..4, so a uniformly drawn value is present about 40% of the time.
+    uint64_t rng = 12345;
+    int64_t v = 0;
+    for (int64_t i = 0; i < large_size; i++) {
+        v += 1 + (int64_t)(bench_random(&rng) % 4);
+        large[i] = v;
+    }
+
+    FILE* csv = fopen("results_intersect.csv", "w");
+    if (csv) {
+        fprintf(csv, "Ratio,Small Size,Large Size,Matches,Method,ms,ns/small key\n");
+    }
+
+    printf("\n%-8s %10s %10s", "Ratio", "Small", "Matches");
+    for (int m = 0; m < 4; m++) printf(" %12s", names[m]);
+    printf("   (ms per intersection)\n");
+    printf("--------------------------------------------------------------------------------\n");
+
+    for (int r = 0; r < (int)(sizeof(ratios) / sizeof(ratios[0])); r++) {
+        int64_t small_size = large_size / ratios[r];
+        // One value per equal slice of the large array's range keeps small sorted.
+        uint64_t span = (uint64_t)v / (uint64_t)small_size;
+        for (int64_t i = 0; i < small_size; i++) {
+            small[i] = (int64_t)(i * span + bench_random(&rng) % span);
+        }
+
+        int64_t matches = speedup_intersect_i64_count(small, small_size, large, large_size);
+        printf("1:%-6lld %10lld %10lld", (long long)ratios[r], (long long)small_size, (long long)matches);
+        for (int m = 0; m < 4; m++) {
+            int64_t result = 0;
+            double ns = time_ns(fns[m], small, small_size, large, large_size, &result);
+            if (result != matches) {
+                fprintf(stderr, "\n%s counted %lld matches, expected %lld\n", names[m], (long long)result, (long long)matches);
+                return 1;
+            }
+            printf(" %12.3f", ns / 1e6);
+            if (csv) {
+                fprintf(csv, "%lld,%lld,%lld,%lld,%s,%.3f,%.2f\n", (long long)ratios[r], (long long)small_size,
+                        (long long)large_size, (long long)matches, names[m], ns / 1e6, ns / small_size);
+            }
+        }
+        printf("\n");
+    }
+
+    if (csv) fclose(csv);
+    free(large);
+    free(small);
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "speedup/api.h"
+#include "bench_common.h"
+
+// Mixed read/write benchmark for speedup_mutable_i64_t. A set of even keys
+// with random gaps (so the uniform-key interpolation path stays out of both
+// sides) takes random lookups mixed with inserts (odd keys) and erases at
+// several write ratios. Static speedup_binary_search_i64 on the same initial
+// array is the read baseline. Per-operation latency includes one clock read, so the
+// percentiles carry ~20 ns of timer overhead; max shows whether merges cause
+// spikes.
+// Usage: speedup_benchmark_mutable [size] [ops]  (default 10000000 2000000)
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char** argv) {
+    int64_t size = 10000000;
+    int64_t ops = 2000000;
+    if (argc > 1) size = strtoll(argv[1], NULL, 10);
+    if (argc > 2) ops = strtoll(argv[2], NULL, 10);
+    if (size < 1000) size = 1000;
+    if (ops < 1000) ops = 1000;
+    const int write_percent[] = {0, 1, 10, 50};
+
+    speedup_init();
+
+    int64_t* array = (int64_t*)malloc(size * sizeof(int64_t));
+    int64_t* keys = (int64_t*)malloc(ops * sizeof(int64_t));
+    double* latency = (double*)malloc(ops * sizeof(double));
+    if (!array || !keys || !latency) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return 1;
+    }
+    uint64_t rng = 12345;
+    int64_t v = 0;
+    for (int64_t i = 0; i < size; i++) {
+        v += 2 + 2 * (int64_t)(bench_random(&rng) % 4);
+        array[i] = v;
+    }
+    for (int64_t i = 0; i < ops; i++) {
+        keys[i] = (int64_t)(bench_random(&rng) % (uint64_t)v);
+        latency[i] = 0;  // fault the pages in before timing
+    }
+
+    // Read baseline: the same lookups on the static array.
+    volatile int64_t sink = 0;
+    double start = bench_time_ns();
+    for (int64_t i = 0; i < ops; i++) {
+        sink += speedup_binary_search_i64(array, keys[i], size);
+    }
+    double static_ns = (bench_time_ns() - start) / ops;
+
+    printf("Mutable Sorted Set\n");
+    printf("==================\n");
+    printf("Initial size: %lld keys, %lld operations per ratio\n", (long long)size, (long long)ops);
+    printf("Static speedup_binary_search_i64: %.1f ns/lookup\n", static_ns);
+
+    FILE* csv = fopen("results_mutable.csv", "w");
+    if (csv) {
+        fprintf(csv, "Write %%,Size,Ops,ns/op,ns/lookup,p50 ns,p99.9 ns,max ns,Static ns/lookup\n");
+    }
+
+    printf("\n%-8s %10s %11s %10s %10s %12s\n", "Writes", "ns/op", "ns/lookup", "p50", "p99.9", "max");
+    printf("----------------------------------------------------------------\n");
+
+    for (int r = 0; r < (int)(sizeof(write_percent) / sizeof(write_percent[0])); r++) {
+        speedup_mutable_i64_t* set = speedup_mutable_i64_create(array, size);
+        if (!set) {
+            fprintf(stderr, "Mutable set creation failed\n");
+            return 1;
+        }
+
+        double lookup_ns = 0;
+        int64_t lookups = 0;
+        double total = bench_time_ns();
+        for (int64_t i = 0; i < ops; i++) {
+            uint64_t pick = bench_random(&rng);
+            double t0 = bench_time_ns();
+            if ((int)(pick % 100) < write_percent[r]) {
+                // Inserts of odd keys and erases of even ones, in equal numbers.
+                if (pick & 128) {
+                    sink += speedup_mutable_i64_insert(set, keys[i] | 1);
+                } else {
+                    sink += speedup_mutable_i64_erase(set, keys[i] & ~(int64_t)1);
+                }
+                latency[i] = bench_time_ns() - t0;
+            } else {
+                sink += speedup_mutable_i64_contains(set, keys[i]);
+                latency[i] = bench_time_ns() - t0;
+                lookup_ns += latency[i];
+                lookups++;
+            }
+        }
+        double per_op = (bench_time_ns() - total) / ops;
+
+        qsort(latency, (size_t)ops, sizeof(double), compare_double);
+        double p50 = latency[ops / 2];
+        double p999 = latency[ops - 1 - ops / 1000];
+        double max = latency[ops - 1];
+        double per_lookup = lookups ? lookup_ns / lookups : 0;
+
+        printf("%6d%% %10.1f %11.1f %10.1f %10.1f %12.1f\n", write_percent[r], per_op, per_lookup, p50, p999, max);
+        if (csv) {
+            fprintf(csv, "%d,%lld,%lld,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n", write_percent[r], (long long)size,
+                    (long long)ops, per_op, per_lookup, p50, p999, max, static_ns);
+        }
+        speedup_mutable_i64_free(set);
+    }
+
+    if (csv) fclose(csv);
+    free(array);
+    free(keys);
+    free(latency);
+    return 0;
+}
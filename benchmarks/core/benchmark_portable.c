@@ -0,0 +1,439 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "speedup/api.h"
+#include "bench_common.h"
+#include "bench_perf.h"
+
+// Portable benchmark harness (Linux, macOS, Windows).
+//
+// Every kernel in the library registry, every index layout, the public
+// dispatching entry point and the batch API are benchmarked automatically,
+// so new kernels show up without touching this file. Results are written in
+// long form (one row per kernel and size) as CSV and JSON. With --perf the
+// timed loop is also measured with hardware counters (Linux only) and the
+// per-search counts are added to both outputs.
+//
+// Arrays and indexes use ordinary pages unless --hugepages is given, which
+// lets the library back them with 2 MB/1 GB pages; run both ways with --perf
+// to compare dtlb_misses_per_search.
+//
+// Usage: speedup_benchmark [--sizes 10000,100000,...] [--keys N]
+//                          [--iterations N] [--filter substr]
+//                          [--csv path] [--json path] [--perf] [--hugepages]
+
+#define MAX_SIZES 32
+#define MAX_CASES 64
+#define MAX_RESULTS (MAX_SIZES * MAX_CASES)
+#define VERIFY_KEYS 1000
+
+typedef enum bench_kind_t {
+    BENCH_KIND_KERNEL,  // registry kernel, called directly
+    BENCH_KIND_API,     // speedup_binary_search_i64 (dispatch + tuning)
+    BENCH_KIND_BATCH,   // speedup_binary_search_i64_batch
+    BENCH_KIND_INDEX    // speedup_index_i64_find on a prebuilt index
+} bench_kind_t;
+
+static const char* kind_names[] = {"kernel", "api", "batch", "index"};
+
+typedef struct bench_case_t {
+    char name[64];
+    bench_kind_t kind;
+    speedup_search_i64_fn fn;
+    speedup_index_layout_t layout;
+} bench_case_t;
+
+typedef struct bench_result_t {
+    const bench_case_t* c;
+    int64_t size;
+    int correct;
+    double ns_per_search;
+    double cycles_per_search;
+    int64_t memory_bytes; // index kinds: bytes held by the index, else -1
+    int64_t model_bytes;  // index kinds: bytes beyond one copy of the keys
+    size_t page_size;     // page size backing the array, 0 for ordinary pages
+    double perf_per_search[BENCH_PERF_COUNTERS];  // NAN when not collected
+} bench_result_t;
+
+typedef struct bench_config_t {
+    int64_t sizes[MAX_SIZES];
+    int num_sizes;
+    int64_t num_keys;
+    int iterations;
+    const char* filter;
+    const char* csv_path;
+    const char* json_path;
+    int perf;
+    int hugepages;
+} bench_config_t;
+
+static bench_case_t g_cases[MAX_CASES];
+static int g_num_cases = 0;
+static bench_result_t g_results[MAX_RESULTS];
+static int g_num_results = 0;
+static bench_perf_t g_perf;
+
+static void add_case(const char* name, bench_kind_t kind, speedup_search_i64_fn fn,
+                     speedup_index_layout_t layout, const char* filter) {
+    if (g_num_cases == MAX_CASES) return;
+    if (filter && !strstr(name, filter)) return;
+    bench_case_t* c = &g_cases[g_num_cases++];
+    snprintf(c->name, sizeof(c->name), "%s", name);
+    c->kind = kind;
+    c->fn = fn;
+    c->layout = layout;
+}
+
+static void register_cases(const char* filter) {
+    for (int i = 0; i < speedup_kernel_count(); i++) {
+        const speedup_kernel_info_t* k = speedup_kernel_get(i);
+        add_case(k->name, BENCH_KIND_KERNEL, k->search_i64, (speedup_index_layout_t)0, filter);
+    }
+    add_case("speedup_binary_search_i64", BENCH_KIND_API, speedup_binary_search_i64, (speedup_index_layout_t)0, filter);
+    add_case("batch", BENCH_KIND_BATCH, NULL, (speedup_index_layout_t)0, filter);
+    for (int layout = 1; speedup_index_layout_name((speedup_index_layout_t)layout); layout++) {
+        char name[64];
+        snprintf(name, sizeof(name), "index_%s", speedup_index_layout_name((speedup_index_layout_t)layout));
+        add_case(name, BENCH_KIND_INDEX, NULL, (speedup_index_layout_t)layout, filter);
+    }
+}
+
+// One search per key for every kind except batch, which does one call per pass.
+static int64_t run_pass(const bench_case_t* c, const speedup_index_i64_t* index,
+                        const int64_t* array, int64_t size,
+                        const int64_t* keys, int64_t num_keys, int64_t* out) {
+    int64_t acc = 0;
+    switch (c->kind) {
+    case BENCH_KIND_KERNEL:
+    case BENCH_KIND_API:
+        for (int64_t k = 0; k < num_keys; k++) acc += c->fn(array, keys[k], size);
+        break;
+    case BENCH_KIND_BATCH:
+        speedup_binary_search_i64_batch(array, size, keys, num_keys, out);
+        acc = out[num_keys - 1];
+        break;
+    case BENCH_KIND_INDEX:
+        for (int64_t k = 0; k < num_keys; k++) acc += speedup_index_i64_find(index, keys[k]);
+        break;
+    }
+    return acc;
+}
+
+static int verify_case(const bench_case_t* c, const speedup_index_i64_t* index,
+                       const int64_t* array, int64_t size,
+                       const int64_t* keys, int64_t num_keys, int64_t* out) {
+    int64_t n = num_keys < VERIFY_KEYS ? num_keys : VERIFY_KEYS;
+    if (c->kind == BENCH_KIND_BATCH) {
+        speedup_binary_search_i64_batch(array, size, keys, n, out);
+    }
+    for (int64_t k = 0; k < n; k++) {
+        int64_t expected = speedup_binary_search_i64_ref(array, keys[k], size);
+        int64_t result;
+        switch (c->kind) {
+        case BENCH_KIND_BATCH: result = out[k]; break;
+        case BENCH_KIND_INDEX: result = speedup_index_i64_find(index, keys[k]); break;
+        default: result = c->fn(array, keys[k], size); break;
+        }
+        if (result != expected) {
+            printf("  %s: got %lld, expected %lld for key %lld\n", c->name,
+                   (long long)result, (long long)expected, (long long)keys[k]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void benchmark_case(const bench_case_t* c, const int64_t* array, int64_t size,
+                           const int64_t* keys, int64_t num_keys, int64_t* out, int iterations) {
+    bench_result_t* r = &g_results[g_num_results++];
+    r->c = c;
+    r->size = size;
+    r->memory_bytes = -1;
+    r->model_bytes = 0;
+    r->page_size = speedup_alloc_page_size(array);
+    for (int i = 0; i < BENCH_PERF_COUNTERS; i++) r->perf_per_search[i] = NAN;
+
+    speedup_index_i64_t* index = NULL;
+    if (c->kind == BENCH_KIND_INDEX) {
+        index = speedup_index_i64_build(c->layout, array, size);
+        if (!index) {
+            printf("%-28s %14s %14s %8s\n", c->name, "BUILD FAILED", "-", "no");
+            r->correct = 0;
+            return;
+        }
+        r->memory_bytes = speedup_index_i64_memory_bytes(index);
+        r->model_bytes = speedup_index_i64_model_bytes(index);
+    }
+
+    r->correct = verify_case(c, index, array, size, keys, num_keys, out);
+    if (r->correct) {
+        volatile int64_t sink = 0;
+        int warmup = iterations / 10 > 0 ? iterations / 10 : 1;
+        for (int iter = 0; iter < warmup; iter++) {
+            sink += run_pass(c, index, array, size, keys, num_keys, out);
+        }
+
+        double counts[BENCH_PERF_COUNTERS];
+        if (g_perf.opened) bench_perf_start(&g_perf);
+        double start_ns = bench_time_ns();
+        uint64_t start_cycles = bench_cycles();
+        for (int iter = 0; iter < iterations; iter++) {
+            sink += run_pass(c, index, array, size, keys, num_keys, out);
+        }
+        uint64_t end_cycles = bench_cycles();
+        double end_ns = bench_time_ns();
+        if (g_perf.opened) bench_perf_stop(&g_perf, counts);
+        (void)sink;
+
+        double searches = (double)iterations * (double)num_keys;
+        r->ns_per_search = (end_ns - start_ns) / searches;
+        r->cycles_per_search = (double)(end_cycles - start_cycles) / searches;
+        printf("%-28s %14.2f %14.2f %8s\n", c->name, r->ns_per_search, r->cycles_per_search, "yes");
+        if (r->memory_bytes >= 0) {
+            printf("%-28s %.3f bytes/key, model %.1f KB (%.3f bytes/key)\n", "",
+                   size > 0 ? (double)r->memory_bytes / (double)size : 0.0, r->model_bytes / 1024.0,
+                   size > 0 ? (double)r->model_bytes / (double)size : 0.0);
+        }
+        if (g_perf.opened) {
+            printf("%-28s", "");
+            for (int i = 0; i < BENCH_PERF_COUNTERS; i++) {
+                r->perf_per_search[i] = counts[i] / searches;
+                if (!isnan(counts[i])) printf(" %s=%.2f", bench_perf_names[i], r->perf_per_search[i]);
+            }
+            printf("\n");
+        }
+    } else {
+        printf("%-28s %14s %14s %8s\n", c->name, "FAILED", "-", "no");
+    }
+
+    speedup_index_i64_free(index);
+}
+
+static void json_string(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        if ((unsigned char)*s >= 0x20) fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+static int write_csv(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) return 0;
+    fprintf(f, "kernel,kind,size,ns_per_search,ref_cycles_per_search,correct,memory_bytes,model_bytes");
+    for (int i = 0; i < BENCH_PERF_COUNTERS; i++) fprintf(f, ",%s_per_search", bench_perf_names[i]);
+    fprintf(f, "\n");
+    for (int i = 0; i < g_num_results; i++) {
+        const bench_result_t* r = &g_results[i];
+        fprintf(f, "%s,%s,%lld,", r->c->name, kind_names[r->c->kind], (long long)r->size);
+        if (r->correct) {
+            fprintf(f, "%.2f,%.2f,1", r->ns_per_search, r->cycles_per_search);
+        } else {
+            fprintf(f, ",,0");
+        }
+        if (r->memory_bytes >= 0) fprintf(f, ",%lld,%lld", (long long)r->memory_bytes, (long long)r->model_bytes);
+        else fprintf(f, ",,");
+        // Counter columns are always present and left empty when not collected.
+        for (int k = 0; k < BENCH_PERF_COUNTERS; k++) {
+            if (isnan(r->perf_per_search[k])) fprintf(f, ",");
+            else fprintf(f, ",%.3f", r->perf_per_search[k]);
+        }
+        fprintf(f, "\n");
+    }
+    fclose(f);
+    return 1;
+}
+
+static int write_json(const char* path, const bench_config_t* cfg, const char* cpu_model) {
+    FILE* f = fopen(path, "w");
+    if (!f) return 0;
+    fprintf(f, "{\n  \"schema\": \"speedup-benchmark/1\",\n");
+    fprintf(f, "  \"library_version\": \"%d.%d.%d\",\n",
+            SPEEDUP_VERSION_MAJOR, SPEEDUP_VERSION_MINOR, SPEEDUP_VERSION_PATCH);
+    fprintf(f, "  \"host\": {\"cpu\": ");
+    json_string(f, cpu_model);
+    fprintf(f, ", \"cores\": %d, \"os\": \"%s\", \"arch\": \"%s\", \"avx2\": %d, \"avx512\": %d},\n",
+            bench_cpu_count(), bench_os(), bench_arch(), speedup_cpu_has_avx2(), speedup_cpu_has_avx512());
+    fprintf(f, "  \"keys\": %lld,\n  \"iterations\": %d,\n  \"perf_counters\": %d,\n  \"huge_pages\": %s,\n",
+            (long long)cfg->num_keys, cfg->iterations, g_perf.opened, cfg->hugepages ? "true" : "false");
+    fprintf(f, "  \"kernels\": [");
+    for (int i = 0; i < g_num_cases; i++) {
+        fprintf(f, "%s{\"name\": ", i ? ", " : "");
+        json_string(f, g_cases[i].name);
+        fprintf(f, ", \"kind\": \"%s\"}", kind_names[g_cases[i].kind]);
+    }
+    fprintf(f, "],\n  \"results\": [\n");
+    for (int i = 0; i < g_num_results; i++) {
+        const bench_result_t* r = &g_results[i];
+        fprintf(f, "    {\"kernel\": ");
+        json_string(f, r->c->name);
+        fprintf(f, ", \"size\": %lld, \"correct\": %s", (long long)r->size, r->correct ? "true" : "false");
+        if (r->memory_bytes >= 0) {
+            fprintf(f, ", \"memory_bytes\": %lld, \"model_bytes\": %lld",
+                    (long long)r->memory_bytes, (long long)r->model_bytes);
+        }
+        fprintf(f, ", \"page_size\": %llu", (unsigned long long)r->page_size);
+        if (r->correct) {
+            fprintf(f, ", \"ns_per_search\": %.2f, \"ref_cycles_per_search\": %.2f",
+                    r->ns_per_search, r->cycles_per_search);
+            int first = 1;
+            for (int k = 0; k < BENCH_PERF_COUNTERS; k++) {
+                if (isnan(r->perf_per_search[k])) continue;
+                fprintf(f, "%s\"%s\": %.3f", first ? ", \"perf_per_search\": {" : ", ",
+                        bench_perf_names[k], r->perf_per_search[k]);
+                first = 0;
+            }
+            if (!first) fprintf(f, "}");
+        }
+        fprintf(f, "}%s\n", i + 1 < g_num_results ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return 1;
+}
+
+static int parse_args(int argc, char** argv, bench_config_t* cfg) {
+    static const int64_t default_sizes[] = {10000, 100000, 1000000, 10000000};
+    cfg->num_sizes = 4;
+    memcpy(cfg->sizes, default_sizes, sizeof(default_sizes));
+    cfg->num_keys = 10000;
+    cfg->iterations = 100;
+    cfg->filter = NULL;
+    cfg->csv_path = "results.csv";
+    cfg->json_path = "results.json";
+    cfg->perf = 0;
+    cfg->hugepages = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--perf") == 0) {
+            cfg->perf = 1;
+            continue;
+        }
+        if (strcmp(arg, "--hugepages") == 0) {
+            cfg->hugepages = 1;
+            continue;
+        }
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!val) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return 0;
+        }
+        if (strcmp(arg, "--sizes") == 0) {
+            cfg->num_sizes = 0;
+            const char* p = val;
+            while (*p && cfg->num_sizes < MAX_SIZES) {
+                int64_t size = strtoll(p, NULL, 10);
+                if (size <= 0) {
+                    fprintf(stderr, "Invalid size list: %s\n", val);
+                    return 0;
+                }
+                cfg->sizes[cfg->num_sizes++] = size;
+                p = strchr(p, ',');
+                if (!p) break;
+                p++;
+            }
+        } else if (strcmp(arg, "--keys") == 0) {
+            cfg->num_keys = strtoll(val, NULL, 10);
+        } else if (strcmp(arg, "--iterations") == 0) {
+            cfg->iterations = atoi(val);
+        } else if (strcmp(arg, "--filter") == 0) {
+            cfg->filter = val;
+        } else if (strcmp(arg, "--csv") == 0) {
+            cfg->csv_path = val;
+        } else if (strcmp(arg, "--json") == 0) {
+            cfg->json_path = val;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return 0;
+        }
+        i++;
+    }
+    if (cfg->num_keys <= 0 || cfg->iterations <= 0) {
+        fprintf(stderr, "--keys and --iterations must be positive\n");
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    bench_config_t cfg;
+    if (!parse_args(argc, argv, &cfg)) return 2;
+
+    speedup_init();
+    speedup_set_page_policy(cfg.hugepages ? SPEEDUP_PAGES_AUTO : SPEEDUP_PAGES_SMALL);
+    register_cases(cfg.filter);
+    for (int i = 0; i < BENCH_PERF_COUNTERS; i++) g_perf.fd[i] = -1;
+    if (cfg.perf && bench_perf_open(&g_perf) == 0) {
+        fprintf(stderr, "Hardware counters unavailable (perf_event_open failed or unsupported OS; "
+                        "check /proc/sys/kernel/perf_event_paranoid); continuing without them\n");
+    }
+
+    char cpu_model[128];
+    bench_cpu_model(cpu_model, sizeof(cpu_model));
+
+    printf("Binary Search Benchmark Suite (%s %s)\n", bench_os(), bench_arch());
+    printf("============================================\n");
+    printf("CPU: %s (%d logical cores)\n", cpu_model, bench_cpu_count());
+    printf("AVX2: %s, AVX-512: %s\n", speedup_cpu_has_avx2() ? "yes" : "no", speedup_cpu_has_avx512() ? "yes" : "no");
+    printf("Kernels:");
+    for (int i = 0; i < g_num_cases; i++) printf(" %s", g_cases[i].name);
+    printf("\n");
+
+    int64_t* keys = (int64_t*)malloc(cfg.num_keys * sizeof(int64_t));
+    int64_t* out = (int64_t*)malloc(cfg.num_keys * sizeof(int64_t));
+    if (!keys || !out) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return 1;
+    }
+
+    for (int s = 0; s < cfg.num_sizes; s++) {
+        int64_t size = cfg.sizes[s];
+        int64_t* array = (int64_t*)speedup_alloc(size * sizeof(int64_t));
+        if (!array) {
+            fprintf(stderr, "Memory allocation failed for size %lld\n", (long long)size);
+            return 1;
+        }
+
+        // Even numbers; keys are a fixed-seed mix of hits and misses.
+        for (int64_t i = 0; i < size; i++) array[i] = i * 2;
+        uint64_t rng = 12345;
+        for (int64_t i = 0; i < cfg.num_keys; i++) {
+            keys[i] = (int64_t)(bench_random(&rng) % (uint64_t)(2 * size));
+        }
+
+        printf("\n========================================\n");
+        printf("Array Size: %lld elements (%.2f MB)\n", (long long)size, size * sizeof(int64_t) / (1024.0 * 1024.0));
+        size_t page_size = speedup_alloc_page_size(array);
+        if (page_size) printf("Pages: %zu KB (huge pages requested)\n", page_size / 1024);
+        else printf("Pages: ordinary\n");
+        printf("Test keys: %lld, Iterations: %d\n", (long long)cfg.num_keys, cfg.iterations);
+        printf("========================================\n");
+        printf("%-28s %14s %14s %8s\n", "Kernel", "ns/search", "ref cycles", "Correct");
+        printf("------------------------------------------------------------------\n");
+
+        for (int c = 0; c < g_num_cases; c++) {
+            benchmark_case(&g_cases[c], array, size, keys, cfg.num_keys, out, cfg.iterations);
+        }
+
+        speedup_free(array);
+    }
+
+    free(keys);
+    free(out);
+    bench_perf_close(&g_perf);
+
+    int ok = 1;
+    if (!write_csv(cfg.csv_path)) {
+        fprintf(stderr, "Failed to write %s\n", cfg.csv_path);
+        ok = 0;
+    }
+    if (!write_json(cfg.json_path, &cfg, cpu_model)) {
+        fprintf(stderr, "Failed to write %s\n", cfg.json_path);
+        ok = 0;
+    }
+    if (ok) printf("\nResults saved to: %s, %s\n", cfg.csv_path, cfg.json_path);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "speedup/api.h"
+#include "bench_common.h"
+
+// Strided search over arrays of records against the copy approach. Records
+// of 16 to 128 bytes carry an int64_t key with random gaps (so the
+// uniform-key interpolation path stays out of the dense baseline). Each row
+// times the strided kernels in place, then a gathered key array searched with
+// speedup_binary_search_i64 and an Eytzinger index built from the records,
+// including their build time. "Break-even" is the number of lookups after
+// which the copy's build cost has paid for itself.
+// Usage: speedup_benchmark_strided [records] [lookups]  (default 1000000 1000000)
+
+typedef int64_t (*strided_fn)(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size);
+
+static double time_strided(strided_fn fn, const char* records, size_t stride, const int64_t* keys, int64_t lookups,
+                           int64_t size, volatile int64_t* sink) {
+    double start = bench_time_ns();
+    for (int64_t i = 0; i < lookups; i++) *sink += fn(records, stride, 0, keys[i], size);
+    return (bench_time_ns() - start) / lookups;
+}
+
+int main(int argc, char** argv) {
+    int64_t size = 1000000;
+    int64_t lookups = 1000000;
+    if (argc > 1) size = strtoll(argv[1], NULL, 10);
+    if (argc > 2) lookups = strtoll(argv[2], NULL, 10);
+    if (size < 1000) size = 1000;
+    if (lookups < 1000) lookups = 1000;
+    const size_t strides[] = {16, 32, 64, 128};
+
+    speedup_init();
+
+    int64_t* keys = (int64_t*)malloc(lookups * sizeof(int64_t));
+    int64_t* dense = (int64_t*)malloc(size * sizeof(int64_t));
+    if (!keys || !dense) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return 1;
+    }
+
+    printf("Strided Record Search\n");
+    printf("=====================\n");
+    printf("Records: %lld, lookups: %lld, key at offset 0\n", (long long)size, (long long)lookups);
+
+    FILE* csv = fopen("results_strided.csv", "w");
+    if (csv) {
+        fprintf(csv, "Record bytes,Records,Strided ref ns,Strided ns,Gather ms,Dense ns,Index build ms,"
+                     "Index ns,Extra MB,Break-even lookups\n");
+    }
+
+    printf("\n%-7s %10s %10s %10s %9s %10s %9s %9s %12s\n", "Record", "ref ns", "strided", "gather ms", "dense ns",
+           "build ms", "index ns", "extra MB", "break-even");
+    printf("-----------------------------------------------------------------------------------------------\n");
+
+    volatile int64_t sink = 0;
+    for (int s = 0; s < (int)(sizeof(strides) / sizeof(strides[0])); s++) {
+        size_t stride = strides[s];
+        char* records = (char*)malloc((size_t)size * stride);
+        if (!records) {
+            fprintf(stderr, "Memory allocation failed\n");
+            return 1;
+        }
+        uint64_t rng = 12345;
+        int64_t v = 0;
+        for (int64_t i = 0; i < size; i++) {
+            v += 1 + (int64_t)(bench_random(&rng) % 8);
+            memset(records + (size_t)i * stride, (int)(i & 0xFF), stride);
+            memcpy(records + (size_t)i * stride, &v, sizeof(v));
+        }
+        for (int64_t i = 0; i < lookups; i++) keys[i] = (int64_t)(bench_random(&rng) % (uint64_t)(v + 1));
+
+        double ref_ns = time_strided(speedup_binary_search_i64_strided_ref, records, stride, keys, lookups, size, &sink);
+        double strided_ns = time_strided(speedup_binary_search_i64_strided, records, stride, keys, lookups, size, &sink);
+
+        double start = bench_time_ns();
+        speedup_keys_gather_i64(records, stride, 0, size, dense);
+        double gather_ms = (bench_time_ns() - start) / 1e6;
+        start = bench_time_ns();
+        for (int64_t i = 0; i < lookups; i++) sink += speedup_binary_search_i64(dense, keys[i], size);
+        double dense_ns = (bench_time_ns() - start) / lookups;
+
+        start = bench_time_ns();
+        speedup_index_i64_t* index =
+            speedup_index_i64_build_records(SPEEDUP_INDEX_LAYOUT_EYTZINGER, records, stride, 0, size);
+        double build_ms = (bench_time_ns() - start) / 1e6;
+        if (!index) {
+            fprintf(stderr, "Index build failed\n");
+            return 1;
+        }
+        start = bench_time_ns();
+        for (int64_t i = 0; i < lookups; i++) sink += speedup_index_i64_find(index, keys[i]);
+        double index_ns = (bench_time_ns() - start) / lookups;
+        double extra_mb = (double)speedup_index_i64_memory_bytes(index) / (1024.0 * 1024.0);
+        speedup_index_i64_free(index);
+
+        double saved = strided_ns - dense_ns;
+        double break_even = saved > 0 ? gather_ms * 1e6 / saved : -1;
+
+        printf("%5zu B %10.1f %10.1f %10.2f %9.1f %10.2f %9.1f %9.1f %12.0f\n", stride, ref_ns, strided_ns, gather_ms,
+               dense_ns, build_ms, index_ns, extra_mb, break_even);
+        if (csv) {
+            fprintf(csv, "%zu,%lld,%.1f,%.1f,%.2f,%.1f,%.2f,%.1f,%.1f,%.0f\n", stride, (long long)size, ref_ns,
+                    strided_ns, gather_ms, dense_ns, build_ms, index_ns, extra_mb, break_even);
+        }
+        free(records);
+    }
+
+    if (csv) fclose(csv);
+    free(keys);
+    free(dense);
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "speedup/api.h"
+#include "bench_common.h"
+
+// Thread scaling benchmark for speedup_binary_search_i64_batch.
+// Usage: speedup_benchmark_threads [max_threads]  (default: all hardware threads)
+
+int main(int argc, char** argv) {
+    const int64_t size = 10000000;
+    const int64_t num_keys = 4000000;
+    const int iterations = 5;
+
+    speedup_init();
+    speedup_set_threads_hint(0);
+    uint32_t max_threads = speedup_get_effective_threads();
+    if (argc > 1) {
+        max_threads = (uint32_t)strtoul(argv[1], NULL, 10);
+        if (max_threads == 0) max_threads = 1;
+    }
+
+    printf("Batch Search Thread Scaling\n");
+    printf("===========================\n");
+    printf("Array Size: %lld elements (%.2f MB), keys per batch: %lld\n",
+           (long long)size, size * sizeof(int64_t) / (1024.0 * 1024.0), (long long)num_keys);
+
+    int64_t* array = (int64_t*)malloc(size * sizeof(int64_t));
+    int64_t* keys = (int64_t*)malloc(num_keys * sizeof(int64_t));
+    int64_t* out = (int64_t*)malloc(num_keys * sizeof(int64_t));
+    if (!array || !keys || !out) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return 1;
+    }
+
+    for (int64_t i = 0; i < size; i++) {
+        array[i] = i * 2;
+    }
+    uint64_t rng = 12345;
+    for (int64_t i = 0; i < num_keys; i++) {
+        keys[i] = (int64_t)(bench_random(&rng) % (uint64_t)(2 * size));  // mix of hits and misses
+    }
+
+    FILE* csv = fopen("results_threads.csv", "w");
+    if (csv) {
+        fprintf(csv, "Threads,Array Size,ns/key,Mkeys/s,Speedup\n");
+    }
+
+    printf("\n%-10s %12s %12s %10s\n", "Threads", "ns/key", "Mkeys/s", "Speedup");
+    printf("------------------------------------------------\n");
+
+    double single = 0;
+    for (uint32_t t = 1; t <= max_threads; t++) {
+        speedup_set_threads_hint(t);
+        speedup_binary_search_i64_batch(array, size, keys, num_keys, out);  // warmup + pool start
+
+        double best = 0;
+        for (int iter = 0; iter < iterations; iter++) {
+            double start = bench_time_ns();
+            speedup_binary_search_i64_batch(array, size, keys, num_keys, out);
+            double elapsed = bench_time_ns() - start;
+            if (iter == 0 || elapsed < best) best = elapsed;
+        }
+
+        double ns_per_key = best / num_keys;
+        if (t == 1) single = ns_per_key;
+        printf("%-10u %12.2f %12.2f %9.2fx\n", t, ns_per_key, 1e3 / ns_per_key, single / ns_per_key);
+        if (csv) {
+            fprintf(csv, "%u,%lld,%.2f,%.2f,%.2f\n", t, (long long)size, ns_per_key, 1e3 / ns_per_key, single / ns_per_key);
+        }
+    }
+
+    if (csv) fclose(csv);
+    free(array);
+    free(keys);
+    free(out);
+    return 0;
+}
@@ -3,13 +3,7 @@
 #include <stdint.h>
 #include <string.h>
 #include <windows.h>
-
-// Feature flags
-#define ENABLE_SIMD 1  // Set to 0 to disable SIMD implementations
-
-#if ENABLE_SIMD
-#include <immintrin.h>  // For AVX2 intrinsics
-#endif
+#include "speedup/api.h"
 
 // Assembly function declarations using Windows calling convention
 __declspec(dllexport) int64_t branching_binary_search_win64(int64_t* array, int64_t key, int64_t size);
@@ -37,186 +31,27 @@ int64_t reference_binary_search(int64_t* array, int64_t key, int64_t size) {
     return -1;
 }
 
-#if ENABLE_SIMD
-// SIMD-optimized binary search using AVX2
-// Strategy: Check 4 positions simultaneously to narrow the search range faster
-int64_t simd_binary_search(int64_t* array, int64_t key, int64_t size) {
-    int64_t left = 0, right = size - 1;
-    
-    // For small arrays, use standard binary search
-    if (size < 32) {
-        return reference_binary_search(array, key, size);
-    }
-    
-    __m256i key_vec = _mm256_set1_epi64x(key);
-    
-    while (right - left > 16) {
-        // Calculate 4 candidate positions
-        int64_t quarter = (right - left + 1) / 4;
-        int64_t pos[4] = {
-            left + quarter,
-            left + quarter * 2,
-            left + quarter * 3,
-            right
-        };
-        
-        // Load 4 values (non-contiguous, so we have to do this manually)
-        __m256i values = _mm256_set_epi64x(
-            array[pos[3]],
-            array[pos[2]],
-            array[pos[1]],
-            array[pos[0]]
-        );
-        
-        // Compare: result[i] = 0xFFFFFFFFFFFFFFFF if array[pos[i]] == key
-        __m256i equal_mask = _mm256_cmpeq_epi64(values, key_vec);
-        
-        // Check if we found the key
-        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(equal_mask));
-        if (mask != 0) {
-            // Found it! Determine which position
-            for (int i = 0; i < 4; i++) {
-                if (mask & (1 << i)) {
-                    return pos[i];
-                }
-            }
-        }
-        
-        // Compare: result[i] = 0xFFFFFFFFFFFFFFFF if array[pos[i]] < key
-        __m256i less_mask = _mm256_cmpgt_epi64(key_vec, values);
-        int less_bits = _mm256_movemask_pd(_mm256_castsi256_pd(less_mask));
-        
-        // Find the narrowest range based on comparisons
-        // If all values < key, search right of pos[3]
-        if (less_bits == 0xF) {
-            left = pos[3] + 1;
-        }
-        // If pos[2] < key <= pos[3], search between pos[2] and pos[3]
-        else if (less_bits == 0x7) {
-            left = pos[2] + 1;
-            right = pos[3] - 1;
-        }
-        // If pos[1] < key <= pos[2], search between pos[1] and pos[2]
-        else if (less_bits == 0x3) {
-            left = pos[1] + 1;
-            right = pos[2] - 1;
-        }
-        // If pos[0] < key <= pos[1], search between pos[0] and pos[1]
-        else if (less_bits == 0x1) {
-            left = pos[0] + 1;
-            right = pos[1] - 1;
-        }
-        // If key <= pos[0], search left of pos[0]
-        else {
-            right = pos[0] - 1;
-        }
-    }
-    
-    // Finish with standard binary search for remaining elements
-    while (left <= right) {
-        int64_t mid = left + (right - left) / 2;
-        
-        if (array[mid] == key) {
-            return mid;
-        } else if (array[mid] < key) {
-            left = mid + 1;
-        } else {
-            right = mid - 1;
-        }
-    }
-    
-    return -1;
+// Library index lookups: the index is rebuilt for every array size in main()
+static speedup_index_i64_t* g_eytzinger_index = NULL;
+static speedup_index_i64_t* g_stree_index = NULL;
+
+int64_t eytzinger_index_search(int64_t* array, int64_t key, int64_t size) {
+    (void)array;
+    (void)size;
+    return speedup_index_i64_find(g_eytzinger_index, key);
 }
 
-// SIMD binary search with software pipelining
-// Combines the best of both optimizations
-int64_t simd_optimized_binary_search(int64_t* array, int64_t key, int64_t size) {
-    int64_t left = 0, right = size - 1;
-    
-    // For very small arrays, use standard binary search
-    if (size < 32) {
-        return reference_binary_search(array, key, size);
-    }
-    
-    __m256i key_vec = _mm256_set1_epi64x(key);
-    
-    // Phase 1: SIMD for large ranges
-    while (right - left > 32) {
-        int64_t quarter = (right - left + 1) / 4;
-        int64_t pos[4] = {
-            left + quarter,
-            left + quarter * 2,
-            left + quarter * 3,
-            right
-        };
-        
-        // Prefetch next potential positions
-        _mm_prefetch((const char*)&array[left + quarter/2], _MM_HINT_T0);
-        _mm_prefetch((const char*)&array[right - quarter/2], _MM_HINT_T0);
-        
-        __m256i values = _mm256_set_epi64x(
-            array[pos[3]],
-            array[pos[2]],
-            array[pos[1]],
-            array[pos[0]]
-        );
-        
-        __m256i equal_mask = _mm256_cmpeq_epi64(values, key_vec);
-        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(equal_mask));
-        
-        if (mask != 0) {
-            for (int i = 0; i < 4; i++) {
-                if (mask & (1 << i)) {
-                    return pos[i];
-                }
-            }
-        }
-        
-        __m256i less_mask = _mm256_cmpgt_epi64(key_vec, values);
-        int less_bits = _mm256_movemask_pd(_mm256_castsi256_pd(less_mask));
-        
-        if (less_bits == 0xF) {
-            left = pos[3] + 1;
-        } else if (less_bits == 0x7) {
-            left = pos[2] + 1;
-            right = pos[3] - 1;
-        } else if (less_bits == 0x3) {
-            left = pos[1] + 1;
-            right = pos[2] - 1;
-        } else if (less_bits == 0x1) {
-            left = pos[0] + 1;
-            right = pos[1] - 1;
-        } else {
-            right = pos[0] - 1;
-        }
-    }
-    
-    // Phase 2: Software-pipelined binary search for remaining elements
-    if (left > right) return -1;
-    
-    int64_t mid = left + (right - left) / 2;
-    int64_t value = array[mid];
-    
-    while (left <= right) {
-        if (value == key) {
-            return mid;
-        }
-        
-        if (value < key) {
-            left = mid + 1;
-        } else {
-            right = mid - 1;
-        }
-        
-        if (left > right) break;
-        
-        mid = left + (right - left) / 2;
-        value = array[mid];  // Load for next iteration
-    }
-    
-    return -1;
+int64_t stree_index_search(int64_t* array, int64_t key, int64_t size) {
+    (void)array;
+    (void)size;
+    return speedup_index_i64_find(g_stree_index, key);
+}
+
+// Library AVX2 kernel (falls back to the prefetching branchless kernel
+// without AVX2)
+int64_t avx2_search(int64_t* array, int64_t key, int64_t size) {
+    return speedup_binary_search_i64_avx2(array, key, size);
 }
-#endif
 
 // Windows high-precision timer
 double get_time_ns() {
@@ -259,6 +94,26 @@ double benchmark_search(int64_t (*search_func)(int64_t*, int64_t, int64_t),
     return total_time / (iterations * num_keys);
 }
 
+// Batch API benchmark: same keys and iterations as benchmark_search, but one
+// speedup_binary_search_i64_batch call per iteration instead of a per-key loop
+double benchmark_batch(int64_t* array, int64_t size,
+                      int64_t* keys, int64_t num_keys, int64_t* out, int iterations) {
+    int warmup = iterations / 10;
+    for (int iter = 0; iter < warmup; iter++) {
+        speedup_binary_search_i64_batch(array, size, keys, num_keys, out);
+    }
+    
+    double total_time = 0;
+    for (int iter = 0; iter < iterations; iter++) {
+        double start = get_time_ns();
+        speedup_binary_search_i64_batch(array, size, keys, num_keys, out);
+        double end = get_time_ns();
+        total_time += (end - start);
+    }
+    
+    return total_time / (iterations * num_keys);
+}
+
 // Verification function
 int verify_function(int64_t (*search_func)(int64_t*, int64_t, int64_t),
                    int64_t* array, int64_t size,
@@ -280,11 +135,7 @@ int main() {
     printf("============================================\n");
     printf("CPU: AMD Ryzen 5 2600X\n");
     
-#if ENABLE_SIMD
-    printf("SIMD: Enabled (AVX2)\n\n");
-#else
-    printf("SIMD: Disabled\n\n");
-#endif
+    printf("SIMD: %s\n\n", speedup_cpu_has_avx2() ? "AVX2" : "none (AVX2 kernel uses its scalar fallback)");
     
     // Test configurations
     int64_t test_sizes[] = {10000, 100000, 1000000, 10000000};
@@ -299,10 +150,9 @@ int main() {
         {"Branching ASM", branching_binary_search_win64},
         {"Branchless ASM", branchless_binary_search_win64},
         {"Optimized ASM", optimized_binary_search_win64},
-#if ENABLE_SIMD
-        {"SIMD AVX2", simd_binary_search},
-        {"SIMD + Optimized", simd_optimized_binary_search},
-#endif
+        {"Eytzinger Index", eytzinger_index_search},
+        {"S-Tree Index", stree_index_search},
+        {"AVX2 (library)", avx2_search},
     };
     int num_funcs = sizeof(functions) / sizeof(functions[0]);
     
@@ -316,10 +166,9 @@ int main() {
     // Write CSV header
     fprintf(csv, "Array Size,Elements,");
     for (int i = 0; i < num_funcs; i++) {
-        fprintf(csv, "%s (ns)", functions[i].name);
-        if (i < num_funcs - 1) fprintf(csv, ",");
+        fprintf(csv, "%s (ns),", functions[i].name);
     }
-    fprintf(csv, "\n");
+    fprintf(csv, "Batch API (ns)\n");
     
     // Run benchmarks for each array size
     for (int size_idx = 0; size_idx < num_sizes; size_idx++) {
@@ -338,8 +187,9 @@ int main() {
         // Allocate and initialize array
         int64_t* array = (int64_t*)_aligned_malloc(size * sizeof(int64_t), 64);
         int64_t* keys = (int64_t*)malloc(num_keys * sizeof(int64_t));
+        int64_t* out = (int64_t*)malloc(num_keys * sizeof(int64_t));
         
-        if (!array || !keys) {
+        if (!array || !keys || !out) {
             fprintf(stderr, "Memory allocation failed for size %lld\n", size);
             fclose(csv);
             return 1;
@@ -360,6 +210,14 @@ int main() {
             }
         }
         
+        g_eytzinger_index = speedup_index_i64_build_eytzinger(array, size);
+        g_stree_index = speedup_index_i64_build_stree(array, size);
+        if (!g_eytzinger_index || !g_stree_index) {
+            fprintf(stderr, "Index build failed for size %lld\n", size);
+            fclose(csv);
+            return 1;
+        }
+        
         printf("\n%-20s %15s %12s\n", "Function", "Time (ns)", "Correct");
         printf("------------------------------------------------\n");
         
@@ -384,14 +242,37 @@ int main() {
                 fprintf(csv, "%.2f", avg_time);
             }
             
-            if (i < num_funcs - 1) fprintf(csv, ",");
+            fprintf(csv, ",");
+        }
+        
+        // Batch API: verify every result against the reference, then measure
+        speedup_binary_search_i64_batch(array, size, keys, num_keys, out);
+        int batch_correct = 1;
+        for (int64_t k = 0; k < num_keys; k++) {
+            if (out[k] != reference_binary_search(array, keys[k], size)) {
+                batch_correct = 0;
+                break;
+            }
+        }
+        if (!batch_correct) {
+            printf("%-20s %15s %12s\n", "Batch API", "FAILED", "✗");
+            fprintf(csv, "FAILED");
+        } else {
+            double avg_time = benchmark_batch(array, size, keys, num_keys, out, iterations);
+            printf("%-20s %15.2f %12s\n", "Batch API", avg_time, "✓");
+            fprintf(csv, "%.2f", avg_time);
         }
         fprintf(csv, "\n");
         fflush(csv);
         
         // Cleanup
+        speedup_index_i64_free(g_eytzinger_index);
+        g_eytzinger_index = NULL;
+        speedup_index_i64_free(g_stree_index);
+        g_stree_index = NULL;
         _aligned_free(array);
         free(keys);
+        free(out);
     }
     
     fclose(csv);
@@ -1,3 +1,251 @@
+"""Generate typed binary search kernels from codegen/types.yaml.
+
+For every scalar type this writes a branchless kernel and a SIMD kernel
+(branchless descent down to a 128-byte window, then one AVX2 compare-and-count
+over the window) to src/algorithms/binary_search/generated/, the matching
+public header include/speedup/algorithms/binary_search_typed.h and a
+sources.cmake fragment that CMakeLists.txt includes. The window holds the
+same number of bytes for every type, so narrow types resolve more elements
+per vector step (64 x 16-bit, 32 x 32-bit, 16 x 64-bit) instead of running a
+copy of the int64 logic.
+
+Usage:
+    python codegen/generate_specializations.py          # (re)write outputs
+    python codegen/generate_specializations.py --check  # fail if stale
+"""
+import argparse
+import sys
 from pathlib import Path
-print("TODO: generate typed specializations from codegen/types.yaml")
-Path("src/algorithms/binary_search/generated/.gitkeep").write_text("", encoding="utf-8")
+
+ROOT = Path(__file__).resolve().parent.parent
+TYPES_YAML = ROOT / "codegen" / "types.yaml"
+SRC_DIR = ROOT / "src" / "algorithms" / "binary_search" / "generated"
+HEADER = ROOT / "include" / "speedup" / "algorithms" / "binary_search_typed.h"
+
+WINDOW_BYTES = 128
+
+BANNER = "/* Generated by codegen/generate_specializations.py from codegen/types.yaml. Do not edit. */\n"
+
+# C type -> (suffix, bytes, AVX2 "lt" mask expression over v and x, bias for
+# unsigned compares or None). The mask has one byte set per byte of each lane
+# that is < key, so the popcount of movemask_epi8 is count * bytes.
+TYPES = {
+    "int16_t": ("i16", 2, "_mm256_cmpgt_epi16(x, v)", None),
+    "uint16_t": ("u16", 2, "_mm256_cmpgt_epi16(x, v)", "_mm256_set1_epi16(INT16_MIN)"),
+    "int32_t": ("i32", 4, "_mm256_cmpgt_epi32(x, v)", None),
+    "uint32_t": ("u32", 4, "_mm256_cmpgt_epi32(x, v)", "_mm256_set1_epi32(INT32_MIN)"),
+    "int64_t": ("i64", 8, "_mm256_cmpgt_epi64(x, v)", None),
+    "uint64_t": ("u64", 8, "_mm256_cmpgt_epi64(x, v)", "_mm256_set1_epi64x(INT64_MIN)"),
+    "float": ("f32", 4, "_mm256_castps_si256(_mm256_cmp_ps(v, x, _CMP_LT_OQ))", None),
+    "double": ("f64", 8, "_mm256_castpd_si256(_mm256_cmp_pd(v, x, _CMP_LT_OQ))", None),
+}
+
+# Entry points that already exist as hand-written int64 kernels; the int64
+# dispatcher owns speedup_binary_search_i64.
+HANDWRITTEN = {"speedup_binary_search_i64", "speedup_binary_search_i64_branchless"}
+
+SET1 = {
+    "i16": "_mm256_set1_epi16(key)",
+    "u16": "_mm256_set1_epi16((int16_t)key)",
+    "i32": "_mm256_set1_epi32(key)",
+    "u32": "_mm256_set1_epi32((int32_t)key)",
+    "i64": "_mm256_set1_epi64x(key)",
+    "u64": "_mm256_set1_epi64x((int64_t)key)",
+    "f32": "_mm256_set1_ps(key)",
+    "f64": "_mm256_set1_pd(key)",
+}
+
+LOAD = {
+    "f32": "_mm256_loadu_ps(start + i)",
+    "f64": "_mm256_loadu_pd(start + i)",
+}
+
+
+def read_types(path):
+    """Reads the `types:` list; a full YAML parser is not needed for it."""
+    types = []
+    in_list = False
+    for raw in path.read_text(encoding="utf-8").splitlines():
+        line = raw.split("#", 1)[0].rstrip()
+        if not line:
+            continue
+        if line.strip() == "types:":
+            in_list = True
+            continue
+        if in_list and line.lstrip().startswith("- "):
+            name = line.lstrip()[2:].strip()
+            if name not in TYPES:
+                raise SystemExit(f"{path}: unsupported type '{name}'")
+            types.append(name)
+        elif not line.startswith((" ", "\t")):
+            in_list = False
+    if not types:
+        raise SystemExit(f"{path}: no types listed")
+    return types
+
+
+def entry_points(ctype):
+    sfx = TYPES[ctype][0]
+    names = [f"speedup_binary_search_{sfx}",
+             f"speedup_binary_search_{sfx}_branchless",
+             f"speedup_binary_search_{sfx}_simd"]
+    return [n for n in names if n not in HANDWRITTEN]
+
+
+def gen_source(ctype):
+    sfx, size, lt, bias = TYPES[ctype]
+    window = WINDOW_BYTES // size
+    lanes = 32 // size
+    shift = {2: 1, 4: 2, 8: 3}[size]
+    names = entry_points(ctype)
+    branchless = f"speedup_binary_search_{sfx}_branchless"
+    simd = f"speedup_binary_search_{sfx}_simd"
+    sig = f"(const {ctype}* array, {ctype} key, int64_t size)"
+
+    load = LOAD.get(sfx, "_mm256_loadu_si256((const __m256i*)(start + i))")
+    if bias:
+        x_init = f"    const __m256i bias = {bias};\n    const __m256i x = _mm256_xor_si256({SET1[sfx]}, bias);\n"
+        v_init = f"_mm256_xor_si256({load}, bias)"
+    else:
+        x_init = f"    const {'__m256' if sfx == 'f32' else '__m256d' if sfx == 'f64' else '__m256i'} x = {SET1[sfx]};\n"
+        v_init = load
+    vtype = "__m256" if sfx == "f32" else "__m256d" if sfx == "f64" else "__m256i"
+
+    out = [BANNER]
+    out.append("#include <stdatomic.h>\n")
+    out.append('#include "speedup/algorithms/binary_search_typed.h"\n')
+    if branchless in HANDWRITTEN:
+        out.append('#include "speedup/algorithms/binary_search.h"\n')
+    out.append('#include "speedup/backend/cpu_features.h"\n')
+    out.append('#include "core/speedup_internal.h"\n\n')
+    out.append("#if SPEEDUP_X86_64\n#include <immintrin.h>\n#endif\n\n")
+    out.append(f"typedef int64_t (*search_{sfx}_fn){sig};\n\n")
+
+    if branchless in names:
+        out.append(
+            f"int64_t {branchless}{sig} {{\n"
+            "    if (size <= 0) return -1;\n\n"
+            f"    const {ctype}* base = array;\n"
+            "    int64_t len = size;\n"
+            "    while (len > 1) {\n"
+            "        int64_t half = len / 2;\n"
+            "        base = (base[half] < key) ? base + half : base;\n"
+            "        len -= half;\n"
+            "    }\n\n"
+            "    int64_t pos = (base - array) + (*base < key);\n"
+            "    return (pos < size && array[pos] == key) ? pos : -1;\n"
+            "}\n\n")
+
+    out.append(
+        "#if SPEEDUP_X86_64\n"
+        f"/* {window} keys = {WINDOW_BYTES} bytes = {window // lanes} vectors of {lanes} lanes. */\n"
+        f"#define WINDOW {window}\n\n"
+        "/* Branchless descent until at most WINDOW candidates remain, then count the\n"
+        " * keys < key in a WINDOW-wide block covering them. The block is moved left\n"
+        " * to stay inside the array; keys left of the descent base are all < key, so\n"
+        " * the count still lands on the lower bound. */\n"
+        "SPEEDUP_TARGET_AVX2\n"
+        f"static int64_t search_{sfx}_avx2{sig} {{\n"
+        f"    if (size < WINDOW) return {branchless}(array, key, size);\n\n"
+        f"    const {ctype}* base = array;\n"
+        "    int64_t len = size;\n"
+        "    while (len > WINDOW) {\n"
+        "        int64_t half = len / 2;\n"
+        "        base = (base[half] < key) ? base + half : base;\n"
+        "        len -= half;\n"
+        "    }\n"
+        f"    const {ctype}* start = (base + WINDOW <= array + size) ? base : array + size - WINDOW;\n\n"
+        f"{x_init}"
+        "    int count = 0;\n"
+        f"    for (int i = 0; i < WINDOW; i += {lanes}) {{\n"
+        f"        const {vtype} v = {v_init};\n"
+        f"        count += speedup_popcount32((uint32_t)_mm256_movemask_epi8({lt}));\n"
+        "    }\n\n"
+        f"    int64_t pos = (start - array) + (count >> {shift});\n"
+        "    return (pos < size && array[pos] == key) ? pos : -1;\n"
+        "}\n\n"
+        "#undef WINDOW\n"
+        "#endif\n\n")
+
+    out.append(
+        f"static int64_t search_{sfx}_resolve{sig};\n"
+        f"static _Atomic(search_{sfx}_fn) search_{sfx}_impl = search_{sfx}_resolve;\n\n"
+        "/* Picks the kernel on first call. Racing first callers pick the same one;\n"
+        " * the pointer is atomic so their stores never race with other readers. */\n"
+        f"static int64_t search_{sfx}_resolve{sig} {{\n"
+        "#if SPEEDUP_X86_64\n"
+        f"    search_{sfx}_fn fn = speedup_cpu_has_avx2() ? search_{sfx}_avx2 : {branchless};\n"
+        "#else\n"
+        f"    search_{sfx}_fn fn = {branchless};\n"
+        "#endif\n"
+        f"    atomic_store_explicit(&search_{sfx}_impl, fn, memory_order_relaxed);\n"
+        "    return fn(array, key, size);\n"
+        "}\n")
+
+    call = f"atomic_load_explicit(&search_{sfx}_impl, memory_order_relaxed)(array, key, size)"
+    out.append(f"\nint64_t {simd}{sig} {{\n    return {call};\n}}\n")
+    top = f"speedup_binary_search_{sfx}"
+    if top in names:
+        out.append(f"\nint64_t {top}{sig} {{\n    return {call};\n}}\n")
+    return "".join(out)
+
+
+def gen_header(types):
+    out = [BANNER, "#pragma once\n#include <stdint.h>\n#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n"]
+    out.append(
+        "/* Typed lookups: index of the first element equal to key, or -1. Arrays must\n"
+        " * be sorted ascending (floating-point arrays must not contain NaN).\n"
+        " * speedup_binary_search_<t> and _simd use the AVX2 window search when the CPU\n"
+        " * has AVX2 and the branchless kernel otherwise; _branchless is always\n"
+        " * scalar. int64_t's top-level and branchless entry points are the\n"
+        " * hand-written ones in binary_search.h. */\n")
+    for ctype in types:
+        out.append("\n")
+        for name in entry_points(ctype):
+            out.append(f"int64_t {name}(const {ctype}* array, {ctype} key, int64_t size);\n")
+    out.append("\n#ifdef __cplusplus\n}\n#endif\n")
+    return "".join(out)
+
+
+def gen_cmake(types):
+    out = ["# Generated by codegen/generate_specializations.py from codegen/types.yaml. Do not edit.\n",
+           "set(SPEEDUP_GENERATED_SOURCES\n"]
+    for ctype in types:
+        out.append(f"    ${{CMAKE_CURRENT_LIST_DIR}}/binary_search_{TYPES[ctype][0]}.c\n")
+    out.append(")\n")
+    return "".join(out)
+
+
+def outputs(types):
+    files = {HEADER: gen_header(types), SRC_DIR / "sources.cmake": gen_cmake(types)}
+    for ctype in types:
+        files[SRC_DIR / f"binary_search_{TYPES[ctype][0]}.c"] = gen_source(ctype)
+    return files
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--check", action="store_true", help="exit 1 if generated files are out of date")
+    args = parser.parse_args()
+
+    files = outputs(read_types(TYPES_YAML))
+    stale = [p for p, text in files.items() if not p.exists() or p.read_text(encoding="utf-8") != text]
+    known = set(files) | {SRC_DIR / ".gitkeep"}
+    extra = [p for p in SRC_DIR.glob("*") if p not in known] if SRC_DIR.exists() else []
+
+    if args.check:
+        for p in stale + extra:
+            print(f"out of date: {p.relative_to(ROOT)}")
+        return 1 if stale or extra else 0
+
+    SRC_DIR.mkdir(parents=True, exist_ok=True)
+    for p in extra:
+        p.unlink()
+    for p in stale:
+        p.write_text(files[p], encoding="utf-8", newline="\n")
+    print(f"generated {len(files)} files ({len(stale)} updated)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
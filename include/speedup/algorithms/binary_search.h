@@ -1,4 +1,98 @@
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 int64_t speedup_binary_search_i64(const int64_t* array, int64_t key, int64_t size);
 int64_t speedup_binary_search_i64_ref(const int64_t* array, int64_t key, int64_t size);
+
+/* Individual CPU kernels, also listed in the kernel registry
+ * (speedup/backend/kernels.h). Branch-free kernels return the first match
+ * when keys repeat. */
+int64_t speedup_binary_search_i64_branchless(const int64_t* array, int64_t key, int64_t size);
+int64_t speedup_binary_search_i64_branchless_prefetch(const int64_t* array, int64_t key, int64_t size);
+/* Prefetching branchless descent to one pair of cache lines, then a single
+ * AVX2 compare-and-count over them; the prefetching kernel when the CPU has
+ * no AVX2. */
+int64_t speedup_binary_search_i64_avx2(const int64_t* array, int64_t key, int64_t size);
+
+/* Interpolation-guided search for near-uniform keys: one interpolation step,
+ * then an exponential search and a branchless finish, so skewed arrays cost
+ * at most about two binary searches. Returns the first match.
+ * speedup_binary_search_i64 uses it only where a tuning profile names the
+ * "interpolation" kernel, since checking the array per lookup costs more than
+ * it saves; speedup_binary_search_i64_batch checks once per batch and takes
+ * the batch form below on arrays that pass. Callers that know their keys can
+ * call either directly. */
+int64_t speedup_binary_search_i64_interpolation(const int64_t* array, int64_t key, int64_t size);
+void speedup_binary_search_i64_batch_interpolation(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out);
+/* 1 when 32 evenly spaced samples all sit within 32 slots of where linear
+ * interpolation between the end keys puts them, else 0. Samples 32 scattered
+ * keys, so check once per array, not per lookup. */
+int speedup_keys_uniform_i64(const int64_t* array, int64_t size);
+
+/* Looks up keys[0..n) in array[0..size) and writes each index (or -1) to out.
+ * Searches are interleaved in groups with software prefetch so several cache
+ * misses are in flight at once. With duplicate keys the first match wins.
+ * Ascending key batches are detected and take the merge path below; other
+ * batches over arrays that pass speedup_keys_uniform_i64 use interpolation. */
+void speedup_binary_search_i64_batch(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out);
+void speedup_binary_search_i64_batch_interleaved(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out);
+
+/* Same contract as speedup_binary_search_i64_batch for keys the caller knows
+ * are non-decreasing. Each search gallops forward from the previous result,
+ * and dense batches degrade to a sequential merge, so cost tends to O(n + size)
+ * instead of O(n log size). */
+void speedup_binary_search_i64_batch_sorted(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out);
+void speedup_binary_search_i64_batch_merge(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out);
+
+/* Bounds: speedup_lower_bound_i64 returns the first index whose element is
+ * >= key, speedup_upper_bound_i64 the first whose element is > key, and size
+ * when there is none, so [lower, upper) is the run of elements equal to key.
+ * speedup_equal_range_i64 stores both. The public forms dispatch once like
+ * speedup_binary_search_i64 (to the CPU kernels: GPU backends have no bounds
+ * yet); the suffixed forms are the individual kernels. */
+int64_t speedup_lower_bound_i64(const int64_t* array, int64_t key, int64_t size);
+int64_t speedup_upper_bound_i64(const int64_t* array, int64_t key, int64_t size);
+void speedup_equal_range_i64(const int64_t* array, int64_t key, int64_t size, int64_t* first, int64_t* last);
+
+int64_t speedup_lower_bound_i64_ref(const int64_t* array, int64_t key, int64_t size);
+int64_t speedup_upper_bound_i64_ref(const int64_t* array, int64_t key, int64_t size);
+int64_t speedup_lower_bound_i64_branchless(const int64_t* array, int64_t key, int64_t size);
+int64_t speedup_upper_bound_i64_branchless(const int64_t* array, int64_t key, int64_t size);
+/* AVX2 window search when the CPU has AVX2, branchless otherwise. */
+int64_t speedup_lower_bound_i64_simd(const int64_t* array, int64_t key, int64_t size);
+int64_t speedup_upper_bound_i64_simd(const int64_t* array, int64_t key, int64_t size);
+
+/* Batch bounds: out[i] (or first[i]/last[i]) for keys[0..n), computed with
+ * the same group-prefetch kernel as speedup_binary_search_i64_batch. */
+void speedup_lower_bound_i64_batch(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out);
+void speedup_upper_bound_i64_batch(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out);
+void speedup_equal_range_i64_batch(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* first, int64_t* last);
+void speedup_lower_bound_i64_batch_interleaved(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out);
+void speedup_upper_bound_i64_batch_interleaved(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out);
+
+/* Searches over arrays of records (structs with an int64_t key field), with
+ * no side array of keys: record i starts at (const char*)base + i * stride
+ * and its key sits key_offset bytes into it. Records must be sorted by key;
+ * keys may be misaligned. Results are record indexes, the first match when
+ * keys repeat. The public form runs the fixed-iteration CMOV kernel (ASM when
+ * linked, else the C twin) on the CPU for every backend preference.
+ * speedup_lower_bound_i64_strided is the bound those kernels use. Records
+ * much larger than their key put every probe on its own cache line, so for
+ * lookup-heavy use a dense copy of the keys (speedup_keys_gather_i64) or an
+ * index built from the records (speedup_index_i64_build_records) can be
+ * faster at the cost of 8 bytes per record. */
+int64_t speedup_binary_search_i64_strided(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size);
+int64_t speedup_binary_search_i64_strided_ref(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size);
+int64_t speedup_binary_search_i64_strided_branchless(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size);
+int64_t speedup_lower_bound_i64_strided(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size);
+
+/* Copies the keys of size records into out. */
+void speedup_keys_gather_i64(const void* base, size_t stride, size_t key_offset, int64_t size, int64_t* out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,47 @@
+/* Generated by codegen/generate_specializations.py from codegen/types.yaml. Do not edit. */
+#pragma once
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Typed lookups: index of the first element equal to key, or -1. Arrays must
+ * be sorted ascending (floating-point arrays must not contain NaN).
+ * speedup_binary_search_<t> and _simd use the AVX2 window search when the CPU
+ * has AVX2 and the branchless kernel otherwise; _branchless is always
+ * scalar. int64_t's top-level and branchless entry points are the
+ * hand-written ones in binary_search.h. */
+
+int64_t speedup_binary_search_i16(const int16_t* array, int16_t key, int64_t size);
+int64_t speedup_binary_search_i16_branchless(const int16_t* array, int16_t key, int64_t size);
+int64_t speedup_binary_search_i16_simd(const int16_t* array, int16_t key, int64_t size);
+
+int64_t speedup_binary_search_u16(const uint16_t* array, uint16_t key, int64_t size);
+int64_t speedup_binary_search_u16_branchless(const uint16_t* array, uint16_t key, int64_t size);
+int64_t speedup_binary_search_u16_simd(const uint16_t* array, uint16_t key, int64_t size);
+
+int64_t speedup_binary_search_i32(const int32_t* array, int32_t key, int64_t size);
+int64_t speedup_binary_search_i32_branchless(const int32_t* array, int32_t key, int64_t size);
+int64_t speedup_binary_search_i32_simd(const int32_t* array, int32_t key, int64_t size);
+
+int64_t speedup_binary_search_u32(const uint32_t* array, uint32_t key, int64_t size);
+int64_t speedup_binary_search_u32_branchless(const uint32_t* array, uint32_t key, int64_t size);
+int64_t speedup_binary_search_u32_simd(const uint32_t* array, uint32_t key, int64_t size);
+
+int64_t speedup_binary_search_i64_simd(const int64_t* array, int64_t key, int64_t size);
+
+int64_t speedup_binary_search_u64(const uint64_t* array, uint64_t key, int64_t size);
+int64_t speedup_binary_search_u64_branchless(const uint64_t* array, uint64_t key, int64_t size);
+int64_t speedup_binary_search_u64_simd(const uint64_t* array, uint64_t key, int64_t size);
+
+int64_t speedup_binary_search_f32(const float* array, float key, int64_t size);
+int64_t speedup_binary_search_f32_branchless(const float* array, float key, int64_t size);
+int64_t speedup_binary_search_f32_simd(const float* array, float key, int64_t size);
+
+int64_t speedup_binary_search_f64(const double* array, double key, int64_t size);
+int64_t speedup_binary_search_f64_branchless(const double* array, double key, int64_t size);
+int64_t speedup_binary_search_f64_simd(const double* array, double key, int64_t size);
+
+#ifdef __cplusplus
+}
+#endif
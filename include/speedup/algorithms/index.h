@@ -0,0 +1,96 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum speedup_index_layout_t {
+    SPEEDUP_INDEX_LAYOUT_EYTZINGER = 1,
+    SPEEDUP_INDEX_LAYOUT_STREE = 2,
+    SPEEDUP_INDEX_LAYOUT_PGM = 3,
+    SPEEDUP_INDEX_LAYOUT_FOR = 4,
+    SPEEDUP_INDEX_LAYOUT_SUMMARY = 5
+} speedup_index_layout_t;
+
+/* Read-only search structure built once from a sorted array. The index owns a
+ * copy of the keys, so the source array may be released after the build.
+ * Lookups return the position of the key in the original sorted array, or -1,
+ * which makes speedup_index_i64_find a drop-in for speedup_binary_search_i64.
+ * With duplicate keys the first matching position is returned. */
+typedef struct speedup_index_i64_t speedup_index_i64_t;
+
+speedup_index_i64_t* speedup_index_i64_build(speedup_index_layout_t layout, const int64_t* sorted, int64_t size);
+speedup_index_i64_t* speedup_index_i64_build_eytzinger(const int64_t* sorted, int64_t size);
+speedup_index_i64_t* speedup_index_i64_build_stree(const int64_t* sorted, int64_t size);
+
+/* Learned index: piecewise-linear models predict each key's position within
+ * +-epsilon, then a branchless search covers the remaining 2 * epsilon + 3
+ * slots. Larger epsilon means fewer segments and a longer last step; 0
+ * selects the default (64, also used by speedup_index_i64_build). Returns
+ * NULL for a negative epsilon. */
+speedup_index_i64_t* speedup_index_i64_build_pgm(const int64_t* sorted, int64_t size, int64_t epsilon);
+
+/* Two-level search: a summary of every k-th key, then one block of k keys of
+ * the sorted array. A positive cache_bytes picks the smallest power of two
+ * k >= 8 whose summary fits it; a budget below one key gives a single-key
+ * summary. cache_bytes 0 (also used by speedup_index_i64_build) sizes it from
+ * speedup_get_cache_hint(): the summary fits the L2 hint when that keeps k at
+ * most 16 (one aligned pair of cache lines per block), else k stays at least
+ * 16 and the summary fits the L3 hint. Returns NULL for a negative
+ * cache_bytes. */
+speedup_index_i64_t* speedup_index_i64_build_summary(const int64_t* sorted, int64_t size, int64_t cache_bytes);
+
+/* Builds an index over the keys of an array of records sorted by key (layout
+ * as in speedup_binary_search_i64_strided). Lookups return record indexes,
+ * and the records are not referenced after the build. */
+speedup_index_i64_t* speedup_index_i64_build_records(speedup_index_layout_t layout, const void* base, size_t stride,
+                                                     size_t key_offset, int64_t size);
+void speedup_index_i64_free(speedup_index_i64_t* index);
+
+int64_t speedup_index_i64_find(const speedup_index_i64_t* index, int64_t key);
+int64_t speedup_index_i64_size(const speedup_index_i64_t* index);
+speedup_index_layout_t speedup_index_i64_layout(const speedup_index_i64_t* index);
+
+/* Bytes held by the index, and the part of it beyond one copy of the keys
+ * (tree nodes, padding, rank arrays or models). Negative for the compressed
+ * SPEEDUP_INDEX_LAYOUT_FOR (frame-of-reference blocks of 128 bit-packed
+ * deltas), which is smaller than the keys it indexes. */
+int64_t speedup_index_i64_memory_bytes(const speedup_index_i64_t* index);
+int64_t speedup_index_i64_model_bytes(const speedup_index_i64_t* index);
+
+/* Copies kept for NUMA replication (see speedup/backend/numa.h), 1 without;
+ * memory_bytes counts all of them. */
+int speedup_index_i64_replica_count(const speedup_index_i64_t* index);
+
+/* Index files store a built index in its search layout (header with format
+ * version, layout, key type, size and checksums, then page-aligned sections),
+ * so later processes can map it instead of rebuilding. speedup_index_i64_open
+ * maps the file read-only and shared: lookups run straight from the page
+ * cache with no copy, every process opening the file shares the same pages,
+ * and only the header is read up front. SPEEDUP_INDEX_OPEN_VERIFY also checks
+ * every section checksum, which reads the whole file. Files use the writer's
+ * byte order and are rejected elsewhere. speedup_index_i64_free closes a
+ * mapped index. speedup_index_i64_save writes to a temporary file and renames
+ * it over path, so readers never see a partial file.
+ * Functions returning int return 0 on success and -1 on failure. */
+#define SPEEDUP_INDEX_FILE_VERSION 1
+
+typedef enum speedup_index_open_flags_t {
+    SPEEDUP_INDEX_OPEN_DEFAULT = 0,
+    SPEEDUP_INDEX_OPEN_VERIFY = 1
+} speedup_index_open_flags_t;
+
+int speedup_index_i64_save(const speedup_index_i64_t* index, const char* path);
+speedup_index_i64_t* speedup_index_i64_open(const char* path, speedup_index_open_flags_t flags);
+
+/* Recomputes the section checksums of an opened index; built indexes always
+ * pass. */
+int speedup_index_i64_verify(const speedup_index_i64_t* index);
+
+/* Returns NULL for values that do not name a layout. */
+const char* speedup_index_layout_name(speedup_index_layout_t layout);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+#include <stdint.h>
+#include "speedup/algorithms/index.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Shared handle to the current version of an index, for reloads under live
+ * traffic. Readers take no locks: entering a read section is one atomic add
+ * on a counter shard chosen per thread (64 shards, one cache line each), so
+ * readers on different threads rarely touch the same line. A writer builds a
+ * new index off to the side and publishes it with one atomic pointer swap.
+ * Readers that entered earlier keep the version they loaded. The writer then
+ * waits for them to leave and frees the old version; readers are never
+ * blocked. Publishers are serialized with each other.
+ *
+ * A read section brackets every use of the pointer from
+ * speedup_index_handle_acquire; sections may nest. speedup_index_handle_find
+ * is one lookup in its own section. The handle owns every published index,
+ * including the one passed to create (which may be NULL: find then returns
+ * -1). speedup_index_handle_free must not race with readers. */
+typedef struct speedup_index_handle_t speedup_index_handle_t;
+
+typedef struct speedup_index_guard_t {
+    uint32_t shard;
+    uint32_t phase;
+} speedup_index_guard_t;
+
+speedup_index_handle_t* speedup_index_handle_create(speedup_index_i64_t* index);
+void speedup_index_handle_free(speedup_index_handle_t* handle);
+
+const speedup_index_i64_t* speedup_index_handle_acquire(speedup_index_handle_t* handle, speedup_index_guard_t* guard);
+void speedup_index_handle_release(speedup_index_handle_t* handle, const speedup_index_guard_t* guard);
+int64_t speedup_index_handle_find(speedup_index_handle_t* handle, int64_t key);
+
+/* Makes index the current version and frees the previous one once no read
+ * section can still use it; returns after freeing it. */
+void speedup_index_handle_publish(speedup_index_handle_t* handle, speedup_index_i64_t* index);
+
+/* Number of versions published so far, counting the initial one as 1. */
+uint64_t speedup_index_handle_version(const speedup_index_handle_t* handle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Intersection of two sorted (non-decreasing) arrays, with the multiset
+ * semantics of std::set_intersection: a value held x times by a and y times
+ * by b matches min(x, y) times, pairing equal elements in order. Matches come
+ * out ascending. Each call picks its strategy from the size ratio: a SIMD
+ * merge (AVX2 4x4 block compares, scalar without AVX2) when the arrays are
+ * within SPEEDUP_INTERSECT_SEARCH_RATIO of each other, otherwise the elements
+ * of the smaller array are looked up in the larger one with the batched,
+ * group-prefetching lower bound kernel, each batch starting past the
+ * previous match. Either array may be the larger.
+ *
+ * speedup_intersect_i64 writes the matched values to out (room for
+ * min(a_size, b_size) values) and returns how many there are.
+ * speedup_intersect_i64_positions writes the positions of each match in a
+ * and in b instead; either output may be NULL. speedup_intersect_i64_count
+ * only counts. The suffixed forms force one strategy. */
+#define SPEEDUP_INTERSECT_SEARCH_RATIO 64
+
+int64_t speedup_intersect_i64(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size, int64_t* out);
+int64_t speedup_intersect_i64_positions(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size,
+                                        int64_t* a_pos, int64_t* b_pos);
+int64_t speedup_intersect_i64_count(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size);
+
+int64_t speedup_intersect_i64_count_merge(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size);
+int64_t speedup_intersect_i64_count_search(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,43 @@
+#pragma once
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Updatable sorted key set. The keys live in one sorted main array, searched
+ * with speedup_binary_search_i64, plus two small sorted buffers of recent
+ * inserts and deletes (tombstones) sized from the L2 cache hint. When a buffer
+ * fills, it is frozen and merged into a new main array a slice at a time:
+ * every later insert or erase does a bounded share of the merge, so the merge
+ * ends well before the fresh buffers fill and no single call pays for a full
+ * rebuild. Lookups check the main array and then at most two cached buffers.
+ * Two main arrays are kept (the one searched and the one merged into), so the
+ * set takes about twice the memory of its keys.
+ *
+ * Keys are a set: duplicates in the initial array collapse to one. One
+ * instance must not be used from several threads at once, lookups included.
+ * insert and erase return 1 when the set changed, 0 when the key was already
+ * present or absent, and -1 when memory for a merge ran out (the set is then
+ * unchanged). */
+typedef struct speedup_mutable_i64_t speedup_mutable_i64_t;
+
+/* Returns NULL when sorted is not in non-decreasing order. */
+speedup_mutable_i64_t* speedup_mutable_i64_create(const int64_t* sorted, int64_t size);
+void speedup_mutable_i64_free(speedup_mutable_i64_t* set);
+
+int speedup_mutable_i64_insert(speedup_mutable_i64_t* set, int64_t key);
+int speedup_mutable_i64_erase(speedup_mutable_i64_t* set, int64_t key);
+int speedup_mutable_i64_contains(const speedup_mutable_i64_t* set, int64_t key);
+int64_t speedup_mutable_i64_size(const speedup_mutable_i64_t* set);
+
+/* Completes any merge in progress and folds both buffers into the main
+ * array, e.g. before a read-only phase. Returns 0, or -1 when out of memory. */
+int speedup_mutable_i64_flush(speedup_mutable_i64_t* set);
+
+/* Keys per buffer; the merge of a full buffer is spread over the next
+ * capacity / 2 changes. */
+int64_t speedup_mutable_i64_buffer_capacity(const speedup_mutable_i64_t* set);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,316 @@
+#pragma once
+#include <stdint.h>
+
+/* Header-only forms of the branch-free CPU kernels. The library's compiled
+ * kernels (branchless, branchless_prefetch, avx2, the interleaved batches,
+ * the Eytzinger and S-tree indexes) are built from these, and the C++ API (speedup/speedup.hpp) calls them
+ * directly, so a caller's loop can inline a search with no call or dispatch
+ * per key. */
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(__GNUC__) || defined(__clang__)
+#define SPEEDUP_INLINE_AVX2 1
+#define SPEEDUP_INLINE_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER)
+#define SPEEDUP_INLINE_AVX2 1
+#define SPEEDUP_INLINE_TARGET_AVX2
+#endif
+#endif
+
+#if defined(SPEEDUP_INLINE_AVX2)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SPEEDUP_INLINE_PREFETCH(addr) __builtin_prefetch((const void*)(addr), 0, 3)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define SPEEDUP_INLINE_PREFETCH(addr) _mm_prefetch((const char*)(addr), _MM_HINT_T0)
+#else
+#define SPEEDUP_INLINE_PREFETCH(addr) ((void)(addr))
+#endif
+
+/* Arrays above this many keys (256 KB, about L2) prefetch both possible next
+ * probes on every level; below it the prefetches only cost instructions. */
+#define SPEEDUP_INLINE_PREFETCH_MIN_KEYS 32768
+
+/* Keys per cache line, and keys in the two-line block the AVX2 finish scans
+ * (also the S-tree node size). */
+#define SPEEDUP_INLINE_LINE_KEYS 8
+#define SPEEDUP_INLINE_BLOCK_KEYS 16
+
+/* Keys searched in lockstep by the interleaved batches. */
+#define SPEEDUP_INLINE_BATCH_GROUP 16
+
+/* What a batch computes per key; a constant argument to the inlined kernels. */
+#define SPEEDUP_INLINE_BATCH_FIND 0   /* first index equal to the key, or -1 */
+#define SPEEDUP_INLINE_BATCH_LOWER 1  /* first index with element >= key */
+#define SPEEDUP_INLINE_BATCH_UPPER 2  /* first index with element > key */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline int speedup_inline_ctz32(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return (int)i;
+#else
+    int n = 0;
+    while (!(x & 1)) { x >>= 1; n++; }
+    return n;
+#endif
+}
+
+static inline int speedup_inline_ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return (int)i;
+#else
+    int n = 0;
+    while (!(x & 1)) { x >>= 1; n++; }
+    return n;
+#endif
+}
+
+/* Fixed-trip-count CMOV descent over [base, base + len): stops once at most
+ * stop candidates remain and returns their first. Keys left of the result are
+ * all < key, and the first key >= key is within stop places of it (or is
+ * array[size]). prefetch is meant to be a constant, so each inlined copy
+ * keeps only one loop. */
+static inline const int64_t* speedup_descend_i64_inline(const int64_t* base, int64_t len, int64_t key, int64_t stop,
+                                                        int prefetch) {
+    while (len > stop) {
+        int64_t half = len / 2;
+        if (prefetch) {
+            int64_t next = (len - half) / 2;
+            SPEEDUP_INLINE_PREFETCH(base + next);
+            SPEEDUP_INLINE_PREFETCH(base + half + next);
+        }
+        base = (base[half] < key) ? base + half : base;
+        len -= half;
+    }
+    return base;
+}
+
+#if defined(SPEEDUP_INLINE_AVX2)
+/* Lower bound from a descent stopped at SPEEDUP_INLINE_LINE_KEYS candidates
+ * (size >= SPEEDUP_INLINE_BLOCK_KEYS): one compare over the two cache lines
+ * holding them. The block starts on the line boundary at or below base and is
+ * moved to stay inside the array; the keys < key in a sorted block form a
+ * prefix, so the first clear bit of the mask is the count. */
+SPEEDUP_INLINE_TARGET_AVX2
+static inline int64_t speedup_block_lower_bound_i64_avx2_inline(const int64_t* array, int64_t size, const int64_t* base,
+                                                                 int64_t key) {
+    const int64_t* start =
+        (const int64_t*)((uintptr_t)base & ~(uintptr_t)(SPEEDUP_INLINE_LINE_KEYS * sizeof(int64_t) - 1));
+    if (start < array) start = array;
+    if (start + SPEEDUP_INLINE_BLOCK_KEYS > array + size) start = array + size - SPEEDUP_INLINE_BLOCK_KEYS;
+
+    const __m256i x = _mm256_set1_epi64x(key);
+    const __m256i lt0 = _mm256_cmpgt_epi64(x, _mm256_loadu_si256((const __m256i*)(start + 0)));
+    const __m256i lt1 = _mm256_cmpgt_epi64(x, _mm256_loadu_si256((const __m256i*)(start + 4)));
+    const __m256i lt2 = _mm256_cmpgt_epi64(x, _mm256_loadu_si256((const __m256i*)(start + 8)));
+    const __m256i lt3 = _mm256_cmpgt_epi64(x, _mm256_loadu_si256((const __m256i*)(start + 12)));
+    uint32_t mask = (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(lt0)) |
+                    (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(lt1)) << 4 |
+                    (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(lt2)) << 8 |
+                    (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(lt3)) << 12;
+    return (start - array) + speedup_inline_ctz32(~mask);
+}
+#endif
+
+/* First index with array[i] >= key, size when there is none. Prefetches on
+ * large arrays; with AVX2 enabled at compile time (__AVX2__) it finishes with
+ * the block compare, as the avx2 kernel does after its runtime check. */
+static inline int64_t speedup_lower_bound_i64_inline(const int64_t* array, int64_t key, int64_t size) {
+    if (size <= 0) return 0;
+#if defined(SPEEDUP_INLINE_AVX2) && defined(__AVX2__)
+    if (size >= SPEEDUP_INLINE_BLOCK_KEYS) {
+        const int64_t* base = size > SPEEDUP_INLINE_PREFETCH_MIN_KEYS
+                                  ? speedup_descend_i64_inline(array, size, key, SPEEDUP_INLINE_LINE_KEYS, 1)
+                                  : speedup_descend_i64_inline(array, size, key, SPEEDUP_INLINE_LINE_KEYS, 0);
+        return speedup_block_lower_bound_i64_avx2_inline(array, size, base, key);
+    }
+#endif
+    const int64_t* base = size > SPEEDUP_INLINE_PREFETCH_MIN_KEYS ? speedup_descend_i64_inline(array, size, key, 1, 1)
+                                                                  : speedup_descend_i64_inline(array, size, key, 1, 0);
+    return (base - array) + (*base < key);
+}
+
+/* First index equal to key, or -1. */
+static inline int64_t speedup_binary_search_i64_inline(const int64_t* array, int64_t key, int64_t size) {
+    int64_t pos = speedup_lower_bound_i64_inline(array, key, size);
+    return (pos < size && array[pos] == key) ? pos : -1;
+}
+
+/* Eytzinger (BFS) descent over keys[1..n]: returns the node holding the
+ * lower bound, or 0 when every key is < key. The eight great-grandchildren of
+ * node k share one cache line and are prefetched three levels ahead. */
+static inline uint64_t speedup_eytzinger_lower_i64_inline(const int64_t* keys, uint64_t n, int64_t key) {
+    uint64_t k = 1;
+    while (k <= n) {
+        SPEEDUP_INLINE_PREFETCH(keys + 8 * k);
+        k = 2 * k + (uint64_t)(keys[k] < key);
+    }
+    /* Undo the trailing right turns plus one left turn. */
+    return k >> (speedup_inline_ctz64(~k) + 1);
+}
+
+/* Group prefetching: every lane of a group (m <= SPEEDUP_INLINE_BATCH_GROUP
+ * keys, size > 0) runs the same branch-free bound, and since the remaining
+ * length depends only on size, all lanes step in lockstep. Each lane
+ * prefetches its next probe right after choosing it, so the load is issued
+ * m - 1 probes before it is needed. */
+static inline void speedup_batch_group_i64_inline(const int64_t* array, int64_t size, const int64_t* keys, int64_t m,
+                                                  int64_t* out, int mode) {
+    const int64_t* base[SPEEDUP_INLINE_BATCH_GROUP];
+    int64_t len = size;
+
+    for (int64_t j = 0; j < m; j++) {
+        base[j] = array;
+    }
+
+    while (len > 1) {
+        int64_t half = len / 2;
+        len -= half;
+        for (int64_t j = 0; j < m; j++) {
+            int below = mode == SPEEDUP_INLINE_BATCH_UPPER ? base[j][half] <= keys[j] : base[j][half] < keys[j];
+            base[j] = below ? base[j] + half : base[j];
+            SPEEDUP_INLINE_PREFETCH(base[j] + len / 2);
+        }
+    }
+
+    for (int64_t j = 0; j < m; j++) {
+        if (mode == SPEEDUP_INLINE_BATCH_UPPER) {
+            out[j] = (base[j] - array) + (*base[j] <= keys[j]);
+            continue;
+        }
+        int64_t pos = (base[j] - array) + (*base[j] < keys[j]);
+        if (mode == SPEEDUP_INLINE_BATCH_LOWER) {
+            out[j] = pos;
+        } else {
+            out[j] = (pos < size && array[pos] == keys[j]) ? pos : -1;
+        }
+    }
+}
+
+/* keys[0..n) against array[0..size), a group at a time. */
+static inline void speedup_batch_i64_inline(const int64_t* array, int64_t size, const int64_t* keys, int64_t n,
+                                            int64_t* out, int mode) {
+    if (size <= 0) {
+        for (int64_t i = 0; i < n; i++) out[i] = mode == SPEEDUP_INLINE_BATCH_FIND ? -1 : 0;
+        return;
+    }
+
+    int64_t i = 0;
+    for (; i + SPEEDUP_INLINE_BATCH_GROUP <= n; i += SPEEDUP_INLINE_BATCH_GROUP) {
+        speedup_batch_group_i64_inline(array, size, keys + i, SPEEDUP_INLINE_BATCH_GROUP, out + i, mode);
+    }
+    if (i < n) {
+        speedup_batch_group_i64_inline(array, size, keys + i, n - i, out + i, mode);
+    }
+}
+
+/* speedup_eytzinger_lower_i64_inline for m <= SPEEDUP_INLINE_BATCH_GROUP
+ * keys at once: each lane's prefetch is in flight while the other lanes
+ * compare. Lanes finish at most one level apart. */
+static inline void speedup_eytzinger_lower_group_i64_inline(const int64_t* keys, uint64_t n, const int64_t* queries,
+                                                            int64_t m, uint64_t* nodes) {
+    for (int64_t j = 0; j < m; j++) nodes[j] = 1;
+    int live = n > 0;
+    while (live) {
+        live = 0;
+        for (int64_t j = 0; j < m; j++) {
+            uint64_t k = nodes[j];
+            if (k <= n) {
+                SPEEDUP_INLINE_PREFETCH(keys + 8 * k);
+                nodes[j] = 2 * k + (uint64_t)(keys[k] < queries[j]);
+                live = 1;
+            }
+        }
+    }
+    for (int64_t j = 0; j < m; j++) nodes[j] >>= speedup_inline_ctz64(~nodes[j]) + 1;
+}
+
+/* S-tree (static B+-tree) with SPEEDUP_INLINE_BLOCK_KEYS-key nodes: layer h
+ * starts at keys + layer_offset[h], leaves (the padded sorted array) first.
+ * A rank is the number of node keys < key; node keys are sorted, so it is
+ * also the node position the search continues from. */
+static inline int64_t speedup_stree_rank_i64_scalar_inline(const int64_t* node, int64_t key) {
+    int64_t r = 0;
+    for (int i = 0; i < SPEEDUP_INLINE_BLOCK_KEYS; i++) r += node[i] < key;
+    return r;
+}
+
+#if defined(SPEEDUP_INLINE_AVX2)
+/* One 64-bit compare per four keys of a 32-byte aligned node; the keys < key
+ * form a prefix of the mask. */
+SPEEDUP_INLINE_TARGET_AVX2
+static inline int64_t speedup_stree_rank_i64_avx2_inline(const int64_t* node, int64_t key) {
+    const __m256i x = _mm256_set1_epi64x(key);
+    const __m256i lt0 = _mm256_cmpgt_epi64(x, _mm256_load_si256((const __m256i*)(node + 0)));
+    const __m256i lt1 = _mm256_cmpgt_epi64(x, _mm256_load_si256((const __m256i*)(node + 4)));
+    const __m256i lt2 = _mm256_cmpgt_epi64(x, _mm256_load_si256((const __m256i*)(node + 8)));
+    const __m256i lt3 = _mm256_cmpgt_epi64(x, _mm256_load_si256((const __m256i*)(node + 12)));
+    uint32_t mask = (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(lt0)) |
+                    (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(lt1)) << 4 |
+                    (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(lt2)) << 8 |
+                    (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(lt3)) << 12;
+    return speedup_inline_ctz32(~mask);
+}
+#endif
+
+/* The AVX2 rank when the caller is compiled with AVX2 (__AVX2__), else the
+ * scalar count; the C index picks between them at run time instead. */
+static inline int64_t speedup_stree_rank_i64_inline(const int64_t* node, int64_t key) {
+#if defined(SPEEDUP_INLINE_AVX2) && defined(__AVX2__)
+    return speedup_stree_rank_i64_avx2_inline(node, key);
+#else
+    return speedup_stree_rank_i64_scalar_inline(node, key);
+#endif
+}
+
+/* Sorted position of the lower bound (up to the padded leaf length). */
+static inline int64_t speedup_stree_lower_i64_inline(const int64_t* keys, const int64_t* layer_offset, int height,
+                                                     int64_t key) {
+    int64_t k = 0;
+    for (int h = height - 1; h > 0; h--) {
+        k = k * (SPEEDUP_INLINE_BLOCK_KEYS + 1) +
+            speedup_stree_rank_i64_inline(keys + layer_offset[h] + k, key) * SPEEDUP_INLINE_BLOCK_KEYS;
+    }
+    return k + speedup_stree_rank_i64_inline(keys + k, key);
+}
+
+/* speedup_stree_lower_i64_inline for m <= SPEEDUP_INLINE_BATCH_GROUP keys in
+ * lockstep: every lane descends the same number of layers, and each
+ * prefetches both lines of its next node right after choosing it. */
+static inline void speedup_stree_lower_group_i64_inline(const int64_t* keys, const int64_t* layer_offset, int height,
+                                                        const int64_t* queries, int64_t m, int64_t* out) {
+    for (int64_t j = 0; j < m; j++) out[j] = 0;
+    for (int h = height - 1; h >= 0; h--) {
+        for (int64_t j = 0; j < m; j++) {
+            int64_t r = speedup_stree_rank_i64_inline(keys + layer_offset[h] + out[j], queries[j]);
+            if (h == 0) {
+                out[j] += r;
+                continue;
+            }
+            out[j] = out[j] * (SPEEDUP_INLINE_BLOCK_KEYS + 1) + r * SPEEDUP_INLINE_BLOCK_KEYS;
+            const int64_t* next = keys + layer_offset[h - 1] + out[j];
+            SPEEDUP_INLINE_PREFETCH(next);
+            SPEEDUP_INLINE_PREFETCH(next + SPEEDUP_INLINE_LINE_KEYS);
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,7 +1,18 @@
 #pragma once
 #include "speedup/version.h"
 #include "speedup/backend/dispatch.h"
+#include "speedup/backend/cpu_features.h"
+#include "speedup/backend/kernels.h"
+#include "speedup/backend/tuning.h"
+#include "speedup/backend/memory.h"
+#include "speedup/backend/numa.h"
 #include "speedup/algorithms/binary_search.h"
+#include "speedup/algorithms/binary_search_typed.h"
+#include "speedup/algorithms/index.h"
+#include "speedup/algorithms/index_handle.h"
+#include "speedup/algorithms/intersect.h"
+#include "speedup/algorithms/mutable_index.h"
+#include "speedup/algorithms/search_inline.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
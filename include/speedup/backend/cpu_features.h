@@ -0,0 +1,19 @@
+#pragma once
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Host CPU capabilities, probed once (CPUID/XGETBV on x86-64, getauxval on
+ * Linux AArch64) and cached. AVX2/AVX-512 also require OS register-state
+ * support, so they report 0 when the OS does not save YMM/ZMM state. */
+int speedup_cpu_has_avx2(void);
+int speedup_cpu_has_avx512(void);
+int speedup_cpu_has_bmi2(void);
+int speedup_cpu_has_neon(void);
+int speedup_cpu_has_sve(void);
+uint32_t speedup_cpu_cacheline_bytes(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -20,5 +20,8 @@ void speedup_set_cache_hint(speedup_cache_hint_t hint);
 void speedup_set_backend_preference(speedup_backend_pref_t pref);
 
 uint32_t speedup_get_threads_hint(void);
+/* Worker count the library actually uses: the threads hint, or the number of
+ * online hardware threads when the hint is 0. */
+uint32_t speedup_get_effective_threads(void);
 speedup_cache_hint_t speedup_get_cache_hint(void);
 speedup_backend_pref_t speedup_get_backend_preference(void);
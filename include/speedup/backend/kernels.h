@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int64_t (*speedup_search_i64_fn)(const int64_t* array, int64_t key, int64_t size);
+
+/* Single-key CPU search kernels usable on this host (ISA requirements are
+ * checked against the CPU feature probes). Names are stable and are what
+ * tuning profiles refer to. */
+typedef struct speedup_kernel_info_t {
+    const char* name;
+    speedup_search_i64_fn search_i64;
+} speedup_kernel_info_t;
+
+int speedup_kernel_count(void);
+const speedup_kernel_info_t* speedup_kernel_get(int i);
+const speedup_kernel_info_t* speedup_kernel_find(const char* name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+#include <stddef.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Page backing for large allocations (>= 2 MB) made with speedup_alloc:
+ * - AUTO: explicit huge pages (MAP_HUGETLB: 1 GB when the block is large
+ *   enough to waste little, else 2 MB), then a 2 MB-aligned mapping advised
+ *   with MADV_HUGEPAGE (transparent huge pages), then ordinary pages.
+ * - SMALL: ordinary pages only, e.g. to measure what huge pages buy.
+ * Linux only; elsewhere every block uses ordinary pages. The policy applies
+ * to later allocations, including the indexes the library builds. */
+typedef enum speedup_page_policy_t {
+    SPEEDUP_PAGES_AUTO = 0,
+    SPEEDUP_PAGES_SMALL = 1
+} speedup_page_policy_t;
+
+void speedup_set_page_policy(speedup_page_policy_t policy);
+speedup_page_policy_t speedup_get_page_policy(void);
+
+/* Allocates bytes aligned to 128 bytes (a pair of cache lines), or returns
+ * NULL. Release with speedup_free, which accepts NULL. */
+void* speedup_alloc(size_t bytes);
+void speedup_free(void* p);
+
+/* Like speedup_alloc, but the block gets its own mapping whose pages prefer
+ * NUMA node (Linux mbind; the kernel falls back to other nodes when it is
+ * full or absent). A negative node, or other platforms, give speedup_alloc.
+ * Release with speedup_free. */
+void* speedup_alloc_on_node(size_t bytes, int node);
+
+/* Page size the block was mapped with: 1 GB or 2 MB for explicit huge pages,
+ * 2 MB for a transparent-huge-page mapping (advisory: the kernel may still
+ * use small pages), 0 for ordinary heap memory. */
+size_t speedup_alloc_page_size(const void* p);
+
+#ifdef __cplusplus
+}
+#endif
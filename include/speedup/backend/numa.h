@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPEEDUP_NUMA_MAX_NODES 64
+
+/* NUMA topology, read once from /sys/devices/system/node on Linux; other
+ * hosts and single-node machines report one node. The SPEEDUP_NUMA_TOPOLOGY
+ * environment variable or speedup_numa_set_topology replaces it with a fake
+ * one: CPU lists per node separated by ';', e.g. "0-3,8-11;4-7,12-15". A CPU
+ * listed under several nodes belongs to the first, so "0;0" gives two nodes on
+ * a one-CPU machine. NULL restores the detected topology.
+ * Functions returning int return 0 on success and -1 on failure. */
+int speedup_numa_set_topology(const char* spec);
+int speedup_numa_node_count(void);
+
+/* Node of the CPU the calling thread runs on (re-read every 1024 calls, so a
+ * migrated thread catches up), or the node given to speedup_numa_bind_thread.
+ * Always in [0, speedup_numa_node_count()). */
+int speedup_numa_current_node(void);
+
+/* Restricts the calling thread to the CPUs of node (best effort: affinity
+ * that the OS or a fake topology cannot honour is skipped) and makes node its
+ * current node from then on. Pool workers are bound this way, spread evenly
+ * over the nodes, whenever there is more than one node. */
+int speedup_numa_bind_thread(int node);
+
+/* With replication on, indexes built afterwards keep one copy per node, each
+ * in memory bound to its node, and speedup_index_i64_find reads the copy of
+ * the calling thread's node. Off by default; single-node hosts and indexes
+ * opened from files keep one copy either way. */
+void speedup_set_numa_replication(int enabled);
+int speedup_get_numa_replication(void);
+
+#ifdef __cplusplus
+}
+#endif
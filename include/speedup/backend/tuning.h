@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Size-banded kernel selection for speedup_binary_search_i64 on the CPU
+ * backend. speedup_calibrate microbenchmarks every registered kernel on
+ * array sizes from 1K up to max_size (powers of 4) and installs the winner
+ * of each band; sizes above max_size use the last band. Profiles are small
+ * text files that later processes load instead of recalibrating.
+ * Functions returning int return 0 on success and -1 on failure. */
+int speedup_calibrate(int64_t max_size);
+int speedup_tuning_save(const char* path);
+int speedup_tuning_load(const char* path);
+void speedup_tuning_reset(void);
+
+/* Kernel name the dispatcher uses for arrays of this size. */
+const char* speedup_tuning_kernel_for_size(int64_t size);
+
+#ifdef __cplusplus
+}
+#endif
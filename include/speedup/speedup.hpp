@@ -0,0 +1,511 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSVC_LANG)
+#define SPEEDUP_CPLUSPLUS _MSVC_LANG
+#else
+#define SPEEDUP_CPLUSPLUS __cplusplus
+#endif
+#if SPEEDUP_CPLUSPLUS >= 202002L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#define SPEEDUP_HAS_SPAN 1
+#endif
+#endif
+
+#include "speedup/algorithms/search_inline.h"
+
+/* Header-only C++ API (C++17; std::span overloads with C++20). Everything here
+ * is a template or inline function over the caller's type, so a search inlines
+ * into the calling loop with no cross-TU call or dispatch per key, and nothing
+ * needs linking. int64_t keys run the same kernels as the C library
+ * (speedup/algorithms/search_inline.h): the branchless descent, with the
+ * prefetch above ~L2 size and, when the caller is compiled with AVX2, the
+ * block compare of speedup_binary_search_i64_avx2; the interleaved batch of
+ * speedup_binary_search_i64_batch_interleaved; and the Eytzinger and S-tree
+ * index descents, with the S-tree's AVX2 node rank under AVX2. Other
+ * arithmetic types run the same algorithms as templates.
+ *
+ *   speedup::sorted_view<T>   search over a sorted array the caller owns
+ *   speedup::index<T, Layout> owned copy in a search layout (layout::sorted,
+ *                             layout::eytzinger, layout::stree)
+ *
+ * Both return positions in the sorted order as std::int64_t, with -1 from
+ * find when the key is missing, and the first match when keys repeat. */
+
+namespace speedup {
+
+namespace detail {
+
+constexpr std::size_t cacheline = 64;
+constexpr int batch_group = SPEEDUP_INLINE_BATCH_GROUP;
+
+/* Owned, cache-line aligned array of trivial values; the layouts keep their
+ * keys in one. */
+template <class T>
+class aligned_array {
+public:
+    aligned_array() = default;
+    explicit aligned_array(std::size_t size)
+        : data_(size ? static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t{cacheline})) : nullptr),
+          size_(size) {}
+    aligned_array(aligned_array&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+    aligned_array& operator=(aligned_array&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+    aligned_array(const aligned_array&) = delete;
+    aligned_array& operator=(const aligned_array&) = delete;
+    ~aligned_array() { release(); }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    T& operator[](std::size_t i) noexcept { return data_[i]; }
+    const T& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+private:
+    void release() noexcept {
+        if (data_) ::operator delete(data_, std::align_val_t{cacheline});
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/* speedup_descend_i64_inline for any T, down to one candidate. */
+template <class T>
+inline const T* descend(const T* base, std::int64_t len, T key, bool prefetch) noexcept {
+    while (len > 1) {
+        std::int64_t half = len / 2;
+        if (prefetch) {
+            std::int64_t next = (len - half) / 2;
+            SPEEDUP_INLINE_PREFETCH(base + next);
+            SPEEDUP_INLINE_PREFETCH(base + half + next);
+        }
+        base = (base[half] < key) ? base + half : base;
+        len -= half;
+    }
+    return base;
+}
+
+template <class T>
+inline std::int64_t lower_bound(const T* data, std::int64_t size, T key) noexcept {
+    if constexpr (std::is_same<T, std::int64_t>::value) {
+        return speedup_lower_bound_i64_inline(data, key, size);
+    } else {
+        if (size <= 0) return 0;
+        const T* base = size > SPEEDUP_INLINE_PREFETCH_MIN_KEYS ? descend(data, size, key, true)
+                                                                : descend(data, size, key, false);
+        return (base - data) + (*base < key);
+    }
+}
+
+template <class T>
+inline std::int64_t upper_bound(const T* data, std::int64_t size, T key) noexcept {
+    if (size <= 0) return 0;
+    const T* base = data;
+    std::int64_t len = size;
+    while (len > 1) {
+        std::int64_t half = len / 2;
+        base = (key < base[half]) ? base : base + half;
+        len -= half;
+    }
+    return (base - data) + !(key < *base);
+}
+
+template <class T>
+inline std::int64_t find(const T* data, std::int64_t size, T key) noexcept {
+    std::int64_t pos = detail::lower_bound(data, size, key);
+    return (pos < size && data[pos] == key) ? pos : -1;
+}
+
+/* Group prefetching as in speedup_binary_search_i64_batch_interleaved (the
+ * same kernel for int64_t): the lanes of a group step in lockstep (the
+ * remaining length depends only on size) and each prefetches its next probe
+ * right after choosing it. */
+template <class T>
+inline void find_batch(const T* data, std::int64_t size, const T* keys, std::int64_t n, std::int64_t* out) noexcept {
+    if constexpr (std::is_same<T, std::int64_t>::value) {
+        speedup_batch_i64_inline(data, size, keys, n, out, SPEEDUP_INLINE_BATCH_FIND);
+        return;
+    }
+    if (size <= 0) {
+        for (std::int64_t i = 0; i < n; i++) out[i] = -1;
+        return;
+    }
+    for (std::int64_t i = 0; i < n; i += batch_group) {
+        std::int64_t m = n - i < batch_group ? n - i : batch_group;
+        const T* base[batch_group];
+        for (std::int64_t j = 0; j < m; j++) base[j] = data;
+        std::int64_t len = size;
+        while (len > 1) {
+            std::int64_t half = len / 2;
+            len -= half;
+            for (std::int64_t j = 0; j < m; j++) {
+                base[j] = (base[j][half] < keys[i + j]) ? base[j] + half : base[j];
+                SPEEDUP_INLINE_PREFETCH(base[j] + len / 2);
+            }
+        }
+        for (std::int64_t j = 0; j < m; j++) {
+            std::int64_t pos = (base[j] - data) + (*base[j] < keys[i + j]);
+            out[i + j] = (pos < size && data[pos] == keys[i + j]) ? pos : -1;
+        }
+    }
+}
+
+}  // namespace detail
+
+/* Non-owning view of a sorted array. */
+template <class T>
+class sorted_view {
+    static_assert(std::is_arithmetic<T>::value, "speedup::sorted_view needs an arithmetic key type");
+
+public:
+    using value_type = T;
+
+    constexpr sorted_view() noexcept = default;
+    constexpr sorted_view(const T* data, std::size_t size) noexcept : data_(data), size_(size) {}
+#if defined(SPEEDUP_HAS_SPAN)
+    constexpr sorted_view(std::span<const T> keys) noexcept : data_(keys.data()), size_(keys.size()) {}
+#endif
+
+    constexpr const T* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    std::int64_t find(T key) const noexcept { return detail::find(data_, ssize(), key); }
+    std::int64_t lower_bound(T key) const noexcept { return detail::lower_bound(data_, ssize(), key); }
+    std::int64_t upper_bound(T key) const noexcept { return detail::upper_bound(data_, ssize(), key); }
+    bool contains(T key) const noexcept { return find(key) >= 0; }
+
+    /* out[i] = find(keys[i]) for n keys. */
+    void find_batch(const T* keys, std::size_t n, std::int64_t* out) const noexcept {
+        detail::find_batch(data_, ssize(), keys, (std::int64_t)n, out);
+    }
+#if defined(SPEEDUP_HAS_SPAN)
+    /* out must hold at least keys.size() results. */
+    void find_batch(std::span<const T> keys, std::span<std::int64_t> out) const noexcept {
+        find_batch(keys.data(), keys.size(), out.data());
+    }
+#endif
+
+private:
+    constexpr std::int64_t ssize() const noexcept { return (std::int64_t)size_; }
+
+    const T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/* Layout policies for speedup::index: each holds its own copy of the keys
+ * and maps a key to its position in the sorted order. */
+namespace layout {
+
+/* The sorted keys themselves, searched like sorted_view. */
+struct sorted {
+    template <class T>
+    class store {
+    public:
+        store() = default;
+        store(const T* keys, std::int64_t size) : keys_((std::size_t)size) {
+            for (std::int64_t i = 0; i < size; i++) keys_[i] = keys[i];
+        }
+
+        std::int64_t size() const noexcept { return (std::int64_t)keys_.size(); }
+        std::size_t memory_bytes() const noexcept { return keys_.size() * sizeof(T); }
+        std::int64_t lower_bound(T key) const noexcept { return detail::lower_bound(keys_.data(), size(), key); }
+        std::int64_t find(T key) const noexcept { return detail::find(keys_.data(), size(), key); }
+        void find_batch(const T* keys, std::int64_t n, std::int64_t* out) const noexcept {
+            detail::find_batch(keys_.data(), size(), keys, n, out);
+        }
+
+    private:
+        detail::aligned_array<T> keys_;
+    };
+};
+
+/* BFS order, as SPEEDUP_INDEX_LAYOUT_EYTZINGER: node k has children 2k and
+ * 2k + 1, the top levels share a few hot cache lines, and the descendants a
+ * cache line further down are prefetched ahead. */
+struct eytzinger {
+    template <class T>
+    class store {
+    public:
+        store() : store(nullptr, 0) {}
+        store(const T* keys, std::int64_t size) : keys_((std::size_t)size + 1), ranks_((std::size_t)size + 1) {
+            keys_[0] = std::numeric_limits<T>::lowest();
+            ranks_[0] = -1;
+            fill(keys, 0, 1);
+        }
+
+        std::int64_t size() const noexcept { return (std::int64_t)keys_.size() - 1; }
+        std::size_t memory_bytes() const noexcept {
+            return keys_.size() * sizeof(T) + ranks_.size() * sizeof(std::int64_t);
+        }
+
+        std::int64_t lower_bound(T key) const noexcept {
+            std::uint64_t k = node(key);
+            return k ? ranks_[k] : size();
+        }
+        std::int64_t find(T key) const noexcept {
+            std::uint64_t k = node(key);
+            return (k && keys_[k] == key) ? ranks_[k] : -1;
+        }
+        /* Groups of keys descend together, as in
+         * speedup_eytzinger_lower_group_i64_inline. */
+        void find_batch(const T* keys, std::int64_t n, std::int64_t* out) const noexcept {
+            std::uint64_t nodes[detail::batch_group];
+            for (std::int64_t i = 0; i < n; i += detail::batch_group) {
+                std::int64_t m = n - i < detail::batch_group ? n - i : detail::batch_group;
+                node_group(keys + i, m, nodes);
+                for (std::int64_t j = 0; j < m; j++) {
+                    std::uint64_t k = nodes[j];
+                    out[i + j] = (k && keys_[k] == keys[i + j]) ? ranks_[k] : -1;
+                }
+            }
+        }
+
+    private:
+        /* In-order walk: tree depth is log2(size), recursion stays shallow. */
+        std::int64_t fill(const T* sorted, std::int64_t i, std::uint64_t k) {
+            if (k <= (std::uint64_t)size()) {
+                i = fill(sorted, i, 2 * k);
+                keys_[k] = sorted[i];
+                ranks_[k] = i++;
+                i = fill(sorted, i, 2 * k + 1);
+            }
+            return i;
+        }
+
+        std::uint64_t node(T key) const noexcept {
+            std::uint64_t n = (std::uint64_t)size();
+            if constexpr (std::is_same<T, std::int64_t>::value) {
+                return speedup_eytzinger_lower_i64_inline(keys_.data(), n, key);
+            } else {
+                /* The line_keys descendants log2(line_keys) levels down are
+                 * contiguous. */
+                constexpr std::uint64_t line_keys = detail::cacheline / sizeof(T) ? detail::cacheline / sizeof(T) : 1;
+                const T* keys = keys_.data();
+                std::uint64_t k = 1;
+                while (k <= n) {
+                    SPEEDUP_INLINE_PREFETCH(keys + line_keys * k);
+                    k = 2 * k + (std::uint64_t)(keys[k] < key);
+                }
+                return k >> (speedup_inline_ctz64(~k) + 1);
+            }
+        }
+
+        void node_group(const T* queries, std::int64_t m, std::uint64_t* nodes) const noexcept {
+            std::uint64_t n = (std::uint64_t)size();
+            if constexpr (std::is_same<T, std::int64_t>::value) {
+                speedup_eytzinger_lower_group_i64_inline(keys_.data(), n, queries, m, nodes);
+            } else {
+                constexpr std::uint64_t line_keys = detail::cacheline / sizeof(T) ? detail::cacheline / sizeof(T) : 1;
+                const T* keys = keys_.data();
+                for (std::int64_t j = 0; j < m; j++) nodes[j] = 1;
+                bool live = n > 0;
+                while (live) {
+                    live = false;
+                    for (std::int64_t j = 0; j < m; j++) {
+                        std::uint64_t k = nodes[j];
+                        if (k <= n) {
+                            SPEEDUP_INLINE_PREFETCH(keys + line_keys * k);
+                            nodes[j] = 2 * k + (std::uint64_t)(keys[k] < queries[j]);
+                            live = true;
+                        }
+                    }
+                }
+                for (std::int64_t j = 0; j < m; j++) nodes[j] >>= speedup_inline_ctz64(~nodes[j]) + 1;
+            }
+        }
+
+        detail::aligned_array<T> keys_;
+        detail::aligned_array<std::int64_t> ranks_;
+    };
+};
+
+/* Static B+-tree, as SPEEDUP_INDEX_LAYOUT_STREE: B keys per node (two cache
+ * lines), B + 1 implicit children, layers stored leaves first. The leaf layer
+ * is the sorted array padded with the largest T (+inf for floating point), so
+ * the leaf offset is the sorted position. Internal key j of a node is the
+ * smallest key of child j + 1. */
+struct stree {
+    template <class T>
+    class store {
+    public:
+        static constexpr std::int64_t B = (std::int64_t)(2 * detail::cacheline / sizeof(T)) > 1
+                                              ? (std::int64_t)(2 * detail::cacheline / sizeof(T))
+                                              : 2;
+        static_assert(!std::is_same<T, std::int64_t>::value || B == SPEEDUP_INLINE_BLOCK_KEYS,
+                      "int64_t nodes must match the shared S-tree kernels");
+
+        store() : store(nullptr, 0) {}
+        store(const T* sorted, std::int64_t size) : size_(size) {
+            offset_[0] = 0;
+            height_ = 1;
+            for (std::int64_t m = size;; m = prev_keys(m)) {
+                std::int64_t layer = blocks(m) > 0 ? blocks(m) * B : B;
+                offset_[height_] = offset_[height_ - 1] + layer;
+                if (m <= B) break;
+                height_++;
+            }
+
+            std::int64_t total = offset_[height_];
+            keys_ = detail::aligned_array<T>((std::size_t)total);
+            T* keys = keys_.data();
+            for (std::int64_t i = 0; i < size; i++) keys[i] = sorted[i];
+            for (std::int64_t i = size; i < total; i++) keys[i] = pad();
+
+            for (int h = 1; h < height_; h++) {
+                std::int64_t count = offset_[h + 1] - offset_[h];
+                for (std::int64_t i = 0; i < count; i++) {
+                    /* Step right of key i once, then follow leftmost children down. */
+                    std::int64_t k = i / B * (B + 1) + i % B + 1;
+                    for (int l = 1; l < h; l++) k *= B + 1;
+                    keys[offset_[h] + i] = k * B < size ? keys[k * B] : pad();
+                }
+            }
+        }
+
+        std::int64_t size() const noexcept { return size_; }
+        std::size_t memory_bytes() const noexcept { return keys_.size() * sizeof(T); }
+
+        std::int64_t lower_bound(T key) const noexcept {
+            std::int64_t pos;
+            if constexpr (std::is_same<T, std::int64_t>::value) {
+                pos = speedup_stree_lower_i64_inline(keys_.data(), offset_, height_, key);
+            } else {
+                const T* keys = keys_.data();
+                std::int64_t k = 0;
+                for (int h = height_ - 1; h > 0; h--) {
+                    k = k * (B + 1) + rank(keys + offset_[h] + k, key) * B;
+                }
+                pos = k + rank(keys + k, key);
+            }
+            /* Keys above every padding value (NaN aside, none once padding is
+             * +inf) count the padding too. */
+            return pos < size_ ? pos : size_;
+        }
+        std::int64_t find(T key) const noexcept {
+            std::int64_t pos = lower_bound(key);
+            return (pos < size_ && keys_[(std::size_t)pos] == key) ? pos : -1;
+        }
+        /* Groups of keys descend together, as in
+         * speedup_stree_lower_group_i64_inline. */
+        void find_batch(const T* keys, std::int64_t n, std::int64_t* out) const noexcept {
+            for (std::int64_t i = 0; i < n; i += detail::batch_group) {
+                std::int64_t m = n - i < detail::batch_group ? n - i : detail::batch_group;
+                lower_group(keys + i, m, out + i);
+                for (std::int64_t j = 0; j < m; j++) {
+                    std::int64_t pos = out[i + j];
+                    out[i + j] = (pos < size_ && keys_[(std::size_t)pos] == keys[i + j]) ? pos : -1;
+                }
+            }
+        }
+
+    private:
+        /* Number of node keys strictly less than key: the int64_t kernels
+         * use speedup_stree_rank_i64_inline (the AVX2 64-bit compare when the
+         * caller is built with AVX2); other types count in this
+         * fixed-length loop. */
+        static std::int64_t rank(const T* node, T key) noexcept {
+            std::int64_t r = 0;
+            for (std::int64_t i = 0; i < B; i++) r += node[i] < key;
+            return r;
+        }
+
+        void lower_group(const T* queries, std::int64_t m, std::int64_t* out) const noexcept {
+            if constexpr (std::is_same<T, std::int64_t>::value) {
+                speedup_stree_lower_group_i64_inline(keys_.data(), offset_, height_, queries, m, out);
+            } else {
+                const T* keys = keys_.data();
+                for (std::int64_t j = 0; j < m; j++) out[j] = 0;
+                for (int h = height_ - 1; h >= 0; h--) {
+                    for (std::int64_t j = 0; j < m; j++) {
+                        std::int64_t r = rank(keys + offset_[h] + out[j], queries[j]);
+                        if (h == 0) {
+                            out[j] += r;
+                            continue;
+                        }
+                        out[j] = out[j] * (B + 1) + r * B;
+                        const T* next = keys + offset_[h - 1] + out[j];
+                        SPEEDUP_INLINE_PREFETCH(next);
+                        SPEEDUP_INLINE_PREFETCH(next + B / 2);
+                    }
+                }
+            }
+        }
+        /* No key compares above the padding, so it never counts in a rank. */
+        static constexpr T pad() noexcept {
+            return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                        : std::numeric_limits<T>::max();
+        }
+        static std::int64_t blocks(std::int64_t n) noexcept { return (n + B - 1) / B; }
+        static std::int64_t prev_keys(std::int64_t n) noexcept { return (blocks(n) + B) / (B + 1) * B; }
+
+        /* B >= 2 and every layer above the leaves is at least B + 1 times
+         * smaller, so 64 layers cover any int64_t size. */
+        static constexpr int max_layers = 64;
+
+        detail::aligned_array<T> keys_;
+        std::int64_t size_ = 0;
+        int height_ = 1;
+        std::int64_t offset_[max_layers + 1] = {};
+    };
+};
+
+}  // namespace layout
+
+/* Owned search structure over a copy of sorted keys, in the given layout. */
+template <class T, class Layout = layout::eytzinger>
+class index {
+    static_assert(std::is_arithmetic<T>::value, "speedup::index needs an arithmetic key type");
+
+public:
+    using value_type = T;
+    using layout_type = Layout;
+
+    index() = default;
+    index(const T* sorted, std::size_t size) : store_(sorted, (std::int64_t)size) {}
+    explicit index(sorted_view<T> sorted) : index(sorted.data(), sorted.size()) {}
+#if defined(SPEEDUP_HAS_SPAN)
+    explicit index(std::span<const T> sorted) : index(sorted.data(), sorted.size()) {}
+#endif
+
+    std::size_t size() const noexcept { return (std::size_t)store_.size(); }
+    bool empty() const noexcept { return store_.size() == 0; }
+    /* Bytes held by the layout's arrays. */
+    std::size_t memory_bytes() const noexcept { return store_.memory_bytes(); }
+
+    std::int64_t find(T key) const noexcept { return store_.find(key); }
+    std::int64_t lower_bound(T key) const noexcept { return store_.lower_bound(key); }
+    bool contains(T key) const noexcept { return store_.find(key) >= 0; }
+
+    /* out[i] = find(keys[i]) for n keys. */
+    void find_batch(const T* keys, std::size_t n, std::int64_t* out) const noexcept {
+        store_.find_batch(keys, (std::int64_t)n, out);
+    }
+#if defined(SPEEDUP_HAS_SPAN)
+    /* out must hold at least keys.size() results. */
+    void find_batch(std::span<const T> keys, std::span<std::int64_t> out) const noexcept {
+        store_.find_batch(keys.data(), (std::int64_t)keys.size(), out.data());
+    }
+#endif
+
+private:
+    typename Layout::template store<T> store_;
+};
+
+}  // namespace speedup
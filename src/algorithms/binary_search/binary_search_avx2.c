@@ -0,0 +1,44 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include "speedup/algorithms/binary_search.h"
+#include "speedup/algorithms/search_inline.h"
+#include "speedup/backend/cpu_features.h"
+#include "core/speedup_internal.h"
+
+typedef int64_t (*search_fn)(const int64_t* array, int64_t key, int64_t size);
+
+#if SPEEDUP_X86_64 && defined(SPEEDUP_INLINE_AVX2)
+/* Prefetching CMOV descent to at most one line of candidates, then one
+ * compare-and-count over the two cache lines holding them
+ * (speedup/algorithms/search_inline.h, shared with the C++ API, which takes
+ * the same path when built with AVX2 enabled). */
+SPEEDUP_TARGET_AVX2
+static int64_t search_avx2(const int64_t* array, int64_t key, int64_t size) {
+    if (size < SPEEDUP_INLINE_BLOCK_KEYS) return speedup_binary_search_i64_branchless(array, key, size);
+
+    const int64_t* base = size > SPEEDUP_INLINE_PREFETCH_MIN_KEYS
+                              ? speedup_descend_i64_inline(array, size, key, SPEEDUP_INLINE_LINE_KEYS, 1)
+                              : speedup_descend_i64_inline(array, size, key, SPEEDUP_INLINE_LINE_KEYS, 0);
+    int64_t pos = speedup_block_lower_bound_i64_avx2_inline(array, size, base, key);
+    return (pos < size && array[pos] == key) ? pos : -1;
+}
+#endif
+
+static int64_t search_resolve(const int64_t* array, int64_t key, int64_t size);
+static _Atomic(search_fn) search_impl = search_resolve;
+
+/* Resolved on first call; callers racing it choose the same kernel, and the
+ * atomic pointer keeps their stores from racing with readers. */
+static int64_t search_resolve(const int64_t* array, int64_t key, int64_t size) {
+#if SPEEDUP_X86_64 && defined(SPEEDUP_INLINE_AVX2)
+    search_fn fn = speedup_cpu_has_avx2() ? search_avx2 : speedup_binary_search_i64_branchless_prefetch;
+#else
+    search_fn fn = speedup_binary_search_i64_branchless_prefetch;
+#endif
+    atomic_store_explicit(&search_impl, fn, memory_order_relaxed);
+    return fn(array, key, size);
+}
+
+int64_t speedup_binary_search_i64_avx2(const int64_t* array, int64_t key, int64_t size) {
+    return atomic_load_explicit(&search_impl, memory_order_relaxed)(array, key, size);
+}
@@ -0,0 +1,75 @@
+#include "speedup/algorithms/binary_search.h"
+#include "core/speedup_internal.h"
+#include "speedup/algorithms/search_inline.h"
+
+/* Group prefetching (speedup_batch_i64_inline, shared with the C++ API):
+ * SPEEDUP_INLINE_BATCH_GROUP searches step in lockstep, each prefetching its
+ * next probe right after choosing it. */
+
+void speedup_binary_search_i64_batch_interleaved(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    speedup_batch_i64_inline(array, size, keys, n, out, SPEEDUP_INLINE_BATCH_FIND);
+}
+
+void speedup_lower_bound_i64_batch_interleaved(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    speedup_batch_i64_inline(array, size, keys, n, out, SPEEDUP_INLINE_BATCH_LOWER);
+}
+
+void speedup_upper_bound_i64_batch_interleaved(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    speedup_batch_i64_inline(array, size, keys, n, out, SPEEDUP_INLINE_BATCH_UPPER);
+}
+
+/* Average gap (array elements per key) below which a linear scan beats
+ * galloping: a gallop costs about 2 * log2(gap) dependent probes. */
+#define SPEEDUP_MERGE_LINEAR_GAP 16
+
+/* First pos in [lo, size) with array[pos] >= key, given array[lo - 1] < key. */
+static int64_t gallop_lower_bound(const int64_t* array, int64_t size, int64_t lo, int64_t key) {
+    int64_t hi = lo;
+    int64_t step = 1;
+    while (hi < size && array[hi] < key) {
+        lo = hi + 1;
+        hi += step;
+        step *= 2;
+    }
+    if (hi > size) hi = size;
+
+    int64_t len = hi - lo;
+    if (len == 0) return lo;
+    const int64_t* base = array + lo;
+    while (len > 1) {
+        int64_t half = len / 2;
+        base = (base[half] < key) ? base + half : base;
+        len -= half;
+    }
+    return (base - array) + (*base < key);
+}
+
+int speedup_keys_sorted_i64(const int64_t* keys, int64_t n) {
+    for (int64_t i = 1; i < n; i++) {
+        if (keys[i] < keys[i - 1]) return 0;
+    }
+    return 1;
+}
+
+void speedup_binary_search_i64_batch_merge(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    if (n <= 0) return;
+
+    /* Density is measured over the span the batch actually covers, so a
+     * sub-range of a larger sorted batch (one thread-pool chunk) is judged
+     * on its own keys. */
+    int64_t pos = gallop_lower_bound(array, size, 0, keys[0]);
+    int64_t last = gallop_lower_bound(array, size, pos, keys[n - 1]);
+
+    if ((last - pos) / n <= SPEEDUP_MERGE_LINEAR_GAP) {
+        for (int64_t i = 0; i < n; i++) {
+            while (pos < size && array[pos] < keys[i]) pos++;
+            out[i] = (pos < size && array[pos] == keys[i]) ? pos : -1;
+        }
+        return;
+    }
+
+    for (int64_t i = 0; i < n; i++) {
+        pos = gallop_lower_bound(array, size, pos, keys[i]);
+        out[i] = (pos < size && array[pos] == keys[i]) ? pos : -1;
+    }
+}
@@ -0,0 +1,148 @@
+#include <stdatomic.h>
+#include "speedup/algorithms/binary_search.h"
+#include "speedup/backend/cpu_features.h"
+#include "core/speedup_internal.h"
+
+#if SPEEDUP_X86_64
+#include <immintrin.h>
+#endif
+
+/* Classic half-open bisection; the branch follows the data. */
+int64_t speedup_lower_bound_i64_ref(const int64_t* array, int64_t key, int64_t size) {
+    int64_t lo = 0;
+    int64_t hi = size > 0 ? size : 0;
+    while (lo < hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (array[mid] < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+int64_t speedup_upper_bound_i64_ref(const int64_t* array, int64_t key, int64_t size) {
+    int64_t lo = 0;
+    int64_t hi = size > 0 ? size : 0;
+    while (lo < hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (array[mid] <= key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* Same fixed-trip-count CMOV loop as speedup_binary_search_i64_branchless,
+ * without the equality check at the end. */
+int64_t speedup_lower_bound_i64_branchless(const int64_t* array, int64_t key, int64_t size) {
+    if (size <= 0) return 0;
+
+    const int64_t* base = array;
+    int64_t len = size;
+    while (len > 1) {
+        int64_t half = len / 2;
+        base = (base[half] < key) ? base + half : base;
+        len -= half;
+    }
+    return (base - array) + (*base < key);
+}
+
+int64_t speedup_upper_bound_i64_branchless(const int64_t* array, int64_t key, int64_t size) {
+    if (size <= 0) return 0;
+
+    const int64_t* base = array;
+    int64_t len = size;
+    while (len > 1) {
+        int64_t half = len / 2;
+        base = (base[half] <= key) ? base + half : base;
+        len -= half;
+    }
+    return (base - array) + (*base <= key);
+}
+
+#if SPEEDUP_X86_64
+/* 16 keys = 128 bytes = 4 vectors of 4 lanes. */
+#define WINDOW 16
+
+/* Branchless descent to at most WINDOW candidates, then one compare-and-count
+ * over a WINDOW-wide block covering them (moved left to stay in the array;
+ * everything left of the descent base is already below the bound). */
+SPEEDUP_TARGET_AVX2
+static inline int64_t bound_avx2(const int64_t* array, int64_t key, int64_t size, int upper) {
+    const int64_t* base = array;
+    int64_t len = size;
+    while (len > WINDOW) {
+        int64_t half = len / 2;
+        int below = upper ? base[half] <= key : base[half] < key;
+        base = below ? base + half : base;
+        len -= half;
+    }
+    const int64_t* start = (base + WINDOW <= array + size) ? base : array + size - WINDOW;
+
+    const __m256i x = _mm256_set1_epi64x(key);
+    int count = 0;
+    for (int i = 0; i < WINDOW; i += 4) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(start + i));
+        /* lower: count v < key; upper: count v > key and take the rest. */
+        const __m256i m = upper ? _mm256_cmpgt_epi64(v, x) : _mm256_cmpgt_epi64(x, v);
+        count += speedup_popcount32((uint32_t)_mm256_movemask_epi8(m));
+    }
+    count >>= 3;
+    return (start - array) + (upper ? WINDOW - count : count);
+}
+
+SPEEDUP_TARGET_AVX2
+static int64_t lower_bound_avx2(const int64_t* array, int64_t key, int64_t size) {
+    if (size < WINDOW) return speedup_lower_bound_i64_branchless(array, key, size);
+    return bound_avx2(array, key, size, 0);
+}
+
+SPEEDUP_TARGET_AVX2
+static int64_t upper_bound_avx2(const int64_t* array, int64_t key, int64_t size) {
+    if (size < WINDOW) return speedup_upper_bound_i64_branchless(array, key, size);
+    return bound_avx2(array, key, size, 1);
+}
+
+#undef WINDOW
+#endif
+
+typedef int64_t (*bound_fn)(const int64_t* array, int64_t key, int64_t size);
+
+static int64_t lower_bound_resolve(const int64_t* array, int64_t key, int64_t size);
+static int64_t upper_bound_resolve(const int64_t* array, int64_t key, int64_t size);
+static _Atomic(bound_fn) lower_bound_simd = lower_bound_resolve;
+static _Atomic(bound_fn) upper_bound_simd = upper_bound_resolve;
+
+/* Pick the kernel on first call. Racing first callers choose the same one,
+ * and the atomic pointers keep those stores from racing with readers. */
+static int64_t lower_bound_resolve(const int64_t* array, int64_t key, int64_t size) {
+#if SPEEDUP_X86_64
+    bound_fn fn = speedup_cpu_has_avx2() ? lower_bound_avx2 : speedup_lower_bound_i64_branchless;
+#else
+    bound_fn fn = speedup_lower_bound_i64_branchless;
+#endif
+    atomic_store_explicit(&lower_bound_simd, fn, memory_order_relaxed);
+    return fn(array, key, size);
+}
+
+static int64_t upper_bound_resolve(const int64_t* array, int64_t key, int64_t size) {
+#if SPEEDUP_X86_64
+    bound_fn fn = speedup_cpu_has_avx2() ? upper_bound_avx2 : speedup_upper_bound_i64_branchless;
+#else
+    bound_fn fn = speedup_upper_bound_i64_branchless;
+#endif
+    atomic_store_explicit(&upper_bound_simd, fn, memory_order_relaxed);
+    return fn(array, key, size);
+}
+
+int64_t speedup_lower_bound_i64_simd(const int64_t* array, int64_t key, int64_t size) {
+    return atomic_load_explicit(&lower_bound_simd, memory_order_relaxed)(array, key, size);
+}
+
+int64_t speedup_upper_bound_i64_simd(const int64_t* array, int64_t key, int64_t size) {
+    return atomic_load_explicit(&upper_bound_simd, memory_order_relaxed)(array, key, size);
+}
@@ -0,0 +1,25 @@
+#include "speedup/algorithms/binary_search.h"
+#include "speedup/algorithms/search_inline.h"
+#include "core/speedup_internal.h"
+
+/* Fixed-trip-count lower bound: the loop runs ceil(log2(size)) times whatever
+ * the key, and the select compiles to CMOV, so there is nothing to mispredict.
+ * This is the shape that wins on small arrays in the baseline analysis. */
+int64_t speedup_binary_search_i64_branchless(const int64_t* array, int64_t key, int64_t size) {
+    if (size <= 0) return -1;
+
+    const int64_t* base = speedup_descend_i64_inline(array, size, key, 1, 0);
+    int64_t pos = (base - array) + (*base < key);
+    return (pos < size && array[pos] == key) ? pos : -1;
+}
+
+/* Branchless variant that prefetches both candidates for the next probe, so
+ * the next load is already in flight whichever way the compare goes. Pays off
+ * once the array no longer fits in cache. */
+int64_t speedup_binary_search_i64_branchless_prefetch(const int64_t* array, int64_t key, int64_t size) {
+    if (size <= 0) return -1;
+
+    const int64_t* base = speedup_descend_i64_inline(array, size, key, 1, 1);
+    int64_t pos = (base - array) + (*base < key);
+    return (pos < size && array[pos] == key) ? pos : -1;
+}
@@ -1,38 +1,256 @@
 #include "speedup/algorithms/binary_search.h"
 #include "speedup/backend/dispatch.h"
+#include "speedup/backend/numa.h"
+#include "index_internal.h"
+#include "kernel_table.h"
+#include "core/thread_pool.h"
+#include "core/speedup_internal.h"
+#include "speedup/config.h"
+
+#if SPEEDUP_ENABLE_ASM
+#include "backends/cpu/x86_64/binary_search_asm.h"
+#endif
 
 int speedup_cuda_available(void);
 int speedup_opencl_available(void);
 int speedup_cuda_binary_search_stub(void);
 int speedup_opencl_binary_search_stub(void);
 
-int64_t speedup_binary_search_i64(const int64_t* array, int64_t key, int64_t size) {
-    speedup_backend_pref_t pref = speedup_get_backend_preference();
-
+/* Returns 1 when the backend preference routes the search to a GPU backend. */
+static int speedup_gpu_search_selected(speedup_backend_pref_t pref) {
     if (pref == SPEEDUP_BACKEND_FORCE_CUDA) {
-        if (speedup_cuda_available() && speedup_cuda_binary_search_stub() == 0) {
-            return -1;
-        }
-        return speedup_binary_search_i64_ref(array, key, size);
+        return speedup_cuda_available() && speedup_cuda_binary_search_stub() == 0;
     }
 
     if (pref == SPEEDUP_BACKEND_FORCE_OPENCL) {
-        if (speedup_opencl_available() && speedup_opencl_binary_search_stub() == 0) {
-            return -1;
-        }
-        return speedup_binary_search_i64_ref(array, key, size);
+        return speedup_opencl_available() && speedup_opencl_binary_search_stub() == 0;
     }
 
     if (pref == SPEEDUP_BACKEND_FORCE_CPU) {
-        return speedup_binary_search_i64_ref(array, key, size);
+        return 0;
     }
 
     if (speedup_cuda_available() && speedup_cuda_binary_search_stub() == 0) {
-        return -1;
+        return 1;
     }
     if (speedup_opencl_available() && speedup_opencl_binary_search_stub() == 0) {
-        return -1;
+        return 1;
+    }
+    return 0;
+}
+
+/* GPU search kernels are not implemented yet; selecting one reports misses. */
+static int64_t speedup_search_i64_gpu(const int64_t* array, int64_t key, int64_t size) {
+    (void)array;
+    (void)key;
+    (void)size;
+    return -1;
+}
+
+static void speedup_batch_i64_gpu(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    (void)array;
+    (void)size;
+    (void)keys;
+    for (int64_t i = 0; i < n; i++) out[i] = -1;
+}
+
+/* Batches below this size are not worth waking the thread pool for. */
+#define SPEEDUP_PARALLEL_MIN_KEYS 65536
+#define SPEEDUP_PARALLEL_GRAIN 8192
+
+typedef struct speedup_batch_job_t {
+    speedup_batch_i64_fn kernel;
+    const int64_t* array;
+    int64_t size;
+    const int64_t* keys;
+    int64_t* out;
+} speedup_batch_job_t;
+
+static void speedup_batch_chunk(void* ctx, int64_t begin, int64_t end) {
+    const speedup_batch_job_t* job = (const speedup_batch_job_t*)ctx;
+    job->kernel(job->array, job->size, job->keys + begin, end - begin, job->out + begin);
+}
+
+static void speedup_run_batch(speedup_batch_i64_fn kernel, const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    if (n < SPEEDUP_PARALLEL_MIN_KEYS || speedup_get_effective_threads() <= 1) {
+        kernel(array, size, keys, n, out);
+        return;
+    }
+
+    speedup_batch_job_t job = {kernel, array, size, keys, out};
+    speedup_parallel_for(n, SPEEDUP_PARALLEL_GRAIN, speedup_batch_chunk, &job);
+}
+
+/* Interpolation is tried on arrays at least this long (below it a binary
+ * search is only a few cached probes) and for batches of at least this many
+ * keys, so the 32 scattered loads of the uniformity check cost under one
+ * load per key. */
+#define SPEEDUP_INTERP_MIN_SIZE 4096
+#define SPEEDUP_INTERP_MIN_KEYS 64
+
+static void speedup_batch_i64_cpu(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    if (speedup_keys_sorted_i64(keys, n)) {
+        speedup_run_batch(speedup_binary_search_i64_batch_merge, array, size, keys, n, out);
+        return;
     }
 
-    return speedup_binary_search_i64_ref(array, key, size);
+    if (size >= SPEEDUP_INTERP_MIN_SIZE && n >= SPEEDUP_INTERP_MIN_KEYS && speedup_keys_uniform_i64(array, size)) {
+        speedup_run_batch(speedup_binary_search_i64_batch_interpolation, array, size, keys, n, out);
+        return;
+    }
+
+    speedup_run_batch(speedup_binary_search_i64_batch_interleaved, array, size, keys, n, out);
+}
+
+static void speedup_batch_sorted_i64_cpu(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    speedup_run_batch(speedup_binary_search_i64_batch_merge, array, size, keys, n, out);
+}
+
+static void speedup_batch_lower_bound_i64_cpu(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    speedup_run_batch(speedup_lower_bound_i64_batch_interleaved, array, size, keys, n, out);
+}
+
+static void speedup_batch_upper_bound_i64_cpu(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    speedup_run_batch(speedup_upper_bound_i64_batch_interleaved, array, size, keys, n, out);
+}
+
+static int64_t speedup_search_i64_lazy(const int64_t* array, int64_t key, int64_t size) {
+    speedup_kernels_resolve();
+    return SPEEDUP_KERNEL(search_i64)(array, key, size);
+}
+
+static void speedup_batch_i64_lazy(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    speedup_kernels_resolve();
+    SPEEDUP_KERNEL(batch_i64)(array, size, keys, n, out);
+}
+
+static void speedup_batch_sorted_i64_lazy(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    speedup_kernels_resolve();
+    SPEEDUP_KERNEL(batch_sorted_i64)(array, size, keys, n, out);
+}
+
+static int64_t speedup_lower_bound_i64_lazy(const int64_t* array, int64_t key, int64_t size) {
+    speedup_kernels_resolve();
+    return SPEEDUP_KERNEL(lower_bound_i64)(array, key, size);
+}
+
+static int64_t speedup_upper_bound_i64_lazy(const int64_t* array, int64_t key, int64_t size) {
+    speedup_kernels_resolve();
+    return SPEEDUP_KERNEL(upper_bound_i64)(array, key, size);
+}
+
+static void speedup_batch_lower_bound_i64_lazy(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    speedup_kernels_resolve();
+    SPEEDUP_KERNEL(batch_lower_bound_i64)(array, size, keys, n, out);
+}
+
+static void speedup_batch_upper_bound_i64_lazy(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    speedup_kernels_resolve();
+    SPEEDUP_KERNEL(batch_upper_bound_i64)(array, size, keys, n, out);
+}
+
+static int64_t speedup_search_strided_i64_lazy(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size) {
+    speedup_kernels_resolve();
+    return SPEEDUP_KERNEL(search_strided_i64)(base, stride, key_offset, key, size);
+}
+
+speedup_kernel_table_t speedup_kernels = {
+    speedup_search_i64_lazy,
+    speedup_batch_i64_lazy,
+    speedup_batch_sorted_i64_lazy,
+    speedup_lower_bound_i64_lazy,
+    speedup_upper_bound_i64_lazy,
+    speedup_batch_lower_bound_i64_lazy,
+    speedup_batch_upper_bound_i64_lazy,
+    speedup_search_strided_i64_lazy
+};
+
+#define SPEEDUP_KERNEL_STORE(entry, fn) atomic_store_explicit(&speedup_kernels.entry, fn, memory_order_release)
+
+void speedup_kernels_resolve(void) {
+    if (speedup_gpu_search_selected(speedup_get_backend_preference())) {
+        SPEEDUP_KERNEL_STORE(search_i64, speedup_search_i64_gpu);
+        SPEEDUP_KERNEL_STORE(batch_i64, speedup_batch_i64_gpu);
+        SPEEDUP_KERNEL_STORE(batch_sorted_i64, speedup_batch_i64_gpu);
+    } else {
+        speedup_search_i64_fn tuned = speedup_tuning_search_i64();
+        SPEEDUP_KERNEL_STORE(search_i64, tuned ? tuned : speedup_kernel_default()->search_i64);
+        SPEEDUP_KERNEL_STORE(batch_i64, speedup_batch_i64_cpu);
+        SPEEDUP_KERNEL_STORE(batch_sorted_i64, speedup_batch_sorted_i64_cpu);
+    }
+
+    /* Bounds and strided searches have no GPU kernels, so they stay on the
+     * CPU for every preference: the fixed-iteration ASM loop when linked,
+     * else its C twin. */
+#if SPEEDUP_ENABLE_ASM
+    SPEEDUP_KERNEL_STORE(lower_bound_i64, SPEEDUP_ASM_KERNEL(lower_bound));
+    SPEEDUP_KERNEL_STORE(upper_bound_i64, SPEEDUP_ASM_KERNEL(upper_bound));
+    SPEEDUP_KERNEL_STORE(search_strided_i64, SPEEDUP_ASM_KERNEL(strided));
+#else
+    SPEEDUP_KERNEL_STORE(lower_bound_i64, speedup_lower_bound_i64_branchless);
+    SPEEDUP_KERNEL_STORE(upper_bound_i64, speedup_upper_bound_i64_branchless);
+    SPEEDUP_KERNEL_STORE(search_strided_i64, speedup_binary_search_i64_strided_branchless);
+#endif
+    SPEEDUP_KERNEL_STORE(batch_lower_bound_i64, speedup_batch_lower_bound_i64_cpu);
+    SPEEDUP_KERNEL_STORE(batch_upper_bound_i64, speedup_batch_upper_bound_i64_cpu);
+}
+
+int64_t speedup_binary_search_i64(const int64_t* array, int64_t key, int64_t size) {
+    return SPEEDUP_KERNEL(search_i64)(array, key, size);
+}
+
+void speedup_binary_search_i64_batch(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    SPEEDUP_KERNEL(batch_i64)(array, size, keys, n, out);
+}
+
+void speedup_binary_search_i64_batch_sorted(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    SPEEDUP_KERNEL(batch_sorted_i64)(array, size, keys, n, out);
+}
+
+int64_t speedup_lower_bound_i64(const int64_t* array, int64_t key, int64_t size) {
+    return SPEEDUP_KERNEL(lower_bound_i64)(array, key, size);
+}
+
+int64_t speedup_binary_search_i64_strided(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size) {
+    return SPEEDUP_KERNEL(search_strided_i64)(base, stride, key_offset, key, size);
+}
+
+int64_t speedup_upper_bound_i64(const int64_t* array, int64_t key, int64_t size) {
+    return SPEEDUP_KERNEL(upper_bound_i64)(array, key, size);
+}
+
+void speedup_equal_range_i64(const int64_t* array, int64_t key, int64_t size, int64_t* first, int64_t* last) {
+    *first = SPEEDUP_KERNEL(lower_bound_i64)(array, key, size);
+    /* Equal keys can only start at or after first. */
+    *last = *first + SPEEDUP_KERNEL(upper_bound_i64)(array + *first, key, size - *first);
+}
+
+void speedup_lower_bound_i64_batch(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    SPEEDUP_KERNEL(batch_lower_bound_i64)(array, size, keys, n, out);
+}
+
+void speedup_upper_bound_i64_batch(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    SPEEDUP_KERNEL(batch_upper_bound_i64)(array, size, keys, n, out);
+}
+
+void speedup_equal_range_i64_batch(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* first, int64_t* last) {
+    SPEEDUP_KERNEL(batch_lower_bound_i64)(array, size, keys, n, first);
+    SPEEDUP_KERNEL(batch_upper_bound_i64)(array, size, keys, n, last);
+}
+
+int64_t speedup_index_i64_find(const speedup_index_i64_t* index, int64_t key) {
+    if (index->replicas) index = index->replicas[speedup_numa_current_node() % index->replica_count];
+    switch (index->layout) {
+    case SPEEDUP_INDEX_LAYOUT_EYTZINGER:
+        return speedup_index_i64_find_eytzinger(index, key);
+    case SPEEDUP_INDEX_LAYOUT_STREE:
+        return speedup_index_i64_find_stree(index, key);
+    case SPEEDUP_INDEX_LAYOUT_PGM:
+        return speedup_index_i64_find_pgm(index, key);
+    case SPEEDUP_INDEX_LAYOUT_FOR:
+        return speedup_index_i64_find_for(index, key);
+    case SPEEDUP_INDEX_LAYOUT_SUMMARY:
+        return speedup_index_i64_find_summary(index, key);
+    }
+    return -1;
 }
@@ -0,0 +1,40 @@
+#include "index_internal.h"
+#include "core/speedup_internal.h"
+#include "speedup/backend/memory.h"
+#include "speedup/algorithms/search_inline.h"
+
+/* Eytzinger (BFS) layout: node k has children 2k and 2k+1, keys[0] is unused.
+ * The first levels of the tree share a handful of cache lines that stay hot,
+ * and the eight descendants of a node three levels down are contiguous, so
+ * they can be prefetched while the current levels are still being compared. */
+
+static int64_t eytzinger_fill(speedup_index_i64_t* index, const int64_t* sorted, int64_t i, int64_t k) {
+    /* In-order walk: tree depth is log2(size), recursion stays shallow. */
+    if (k <= index->size) {
+        i = eytzinger_fill(index, sorted, i, 2 * k);
+        index->keys[k] = sorted[i];
+        index->ranks[k] = i;
+        i++;
+        i = eytzinger_fill(index, sorted, i, 2 * k + 1);
+    }
+    return i;
+}
+
+int speedup_index_i64_init_eytzinger(speedup_index_i64_t* index, const int64_t* sorted) {
+    size_t bytes = (size_t)(index->size + 1) * sizeof(int64_t);
+    index->keys = (int64_t*)speedup_alloc(bytes);
+    index->ranks = (int64_t*)speedup_alloc(bytes);
+    if (!index->keys || !index->ranks) return 0;
+
+    index->keys[0] = INT64_MIN;
+    index->ranks[0] = -1;
+    eytzinger_fill(index, sorted, 0, 1);
+    return 1;
+}
+
+int64_t speedup_index_i64_find_eytzinger(const speedup_index_i64_t* index, int64_t key) {
+    const int64_t* keys = index->keys;
+    uint64_t k = speedup_eytzinger_lower_i64_inline(keys, (uint64_t)index->size, key);
+    if (k == 0 || keys[k] != key) return -1;
+    return index->ranks[k];
+}
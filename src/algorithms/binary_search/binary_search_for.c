@@ -0,0 +1,189 @@
+#include "index_internal.h"
+#include "core/speedup_internal.h"
+#include "speedup/backend/memory.h"
+#include "speedup/backend/cpu_features.h"
+
+#if SPEEDUP_X86_64
+#include <immintrin.h>
+#endif
+
+/* Frame-of-reference compression: the sorted keys are cut into blocks of 128.
+ * Each block keeps its first key at full width and stores every key as its
+ * delta from that base, bit-packed at the width of the block's largest delta,
+ * so dense IDs take a byte or two per key. keys holds, in 64-bit words:
+ *   [0, 2 * nb)       per block, its base followed by a descriptor (word
+ *                     offset of the packed deltas << 8 | bit width), so the
+ *                     base that selects a block shares its cache line
+ *   [2 * nb, ...)     packed deltas, each block starting on a word, followed
+ *                     by 16 zero words so decoding (up to 16 lanes past the
+ *                     last key) never reads past the end
+ * layer_offset[1] is the total word count. A lookup searches the bases (1/128
+ * of the keys) and then decodes a handful of deltas from one block. */
+
+#define BLOCK SPEEDUP_FOR_BLOCK
+#define PAD_WORDS 16
+
+static inline int for_width(uint64_t max_delta) {
+    int w = 0;
+    while (w < 64 && (max_delta >> w)) w++;
+    return w;
+}
+
+static inline uint64_t for_mask(int w) {
+    return w == 64 ? ~(uint64_t)0 : ((uint64_t)1 << w) - 1;
+}
+
+/* Delta i of a block packed at width w (w in [0, 64]). */
+static inline uint64_t for_get(const uint64_t* p, int64_t i, int w, uint64_t mask) {
+    uint64_t bit = (uint64_t)i * (uint64_t)w;
+    uint64_t word = bit >> 6;
+    unsigned shift = (unsigned)(bit & 63);
+    /* Two shifts keep the high part defined when shift is 0. */
+    uint64_t v = (p[word] >> shift) | ((p[word + 1] << 1) << (63 - shift));
+    return v & mask;
+}
+
+int speedup_index_i64_init_for(speedup_index_i64_t* index, const int64_t* sorted) {
+    int64_t n = index->size;
+    int64_t nb = (n + BLOCK - 1) / BLOCK;
+
+    int64_t words = 2 * nb + PAD_WORDS;
+    for (int64_t b = 0; b < nb; b++) {
+        int64_t first = b * BLOCK;
+        int64_t len = n - first < BLOCK ? n - first : BLOCK;
+        int w = for_width((uint64_t)sorted[first + len - 1] - (uint64_t)sorted[first]);
+        words += (len * w + 63) / 64;
+    }
+
+    index->keys = (int64_t*)speedup_alloc((size_t)words * sizeof(int64_t));
+    if (!index->keys) return 0;
+    index->height = 1;
+    index->layer_offset[0] = 0;
+    index->layer_offset[1] = words;
+
+    uint64_t* out = (uint64_t*)index->keys;
+    for (int64_t i = 2 * nb; i < words; i++) out[i] = 0;
+    uint64_t offset = (uint64_t)(2 * nb);
+    for (int64_t b = 0; b < nb; b++) {
+        int64_t first = b * BLOCK;
+        int64_t len = n - first < BLOCK ? n - first : BLOCK;
+        uint64_t base = (uint64_t)sorted[first];
+        int w = for_width((uint64_t)sorted[first + len - 1] - base);
+
+        out[2 * b] = base;
+        out[2 * b + 1] = offset << 8 | (uint64_t)w;
+        uint64_t* p = out + offset;
+        for (int64_t i = 0; i < len && w > 0; i++) {
+            uint64_t d = (uint64_t)sorted[first + i] - base;
+            uint64_t bit = (uint64_t)i * (uint64_t)w;
+            unsigned shift = (unsigned)(bit & 63);
+            p[bit >> 6] |= d << shift;
+            if (shift + (unsigned)w > 64) p[(bit >> 6) + 1] |= d >> (64 - shift);
+        }
+        offset += (uint64_t)((len * w + 63) / 64);
+    }
+
+    index->use_avx2 = SPEEDUP_X86_64 && speedup_cpu_has_avx2();
+    return 1;
+}
+
+/* First delta in [0, len) that is >= t; the branchless loop of
+ * speedup_lower_bound_i64_branchless over packed values. */
+static inline int64_t block_lower_bound_scalar(const uint64_t* p, int w, int64_t len, uint64_t t) {
+    uint64_t mask = for_mask(w);
+    int64_t lo = 0;
+    while (len > 1) {
+        int64_t half = len / 2;
+        lo = (for_get(p, lo + half, w, mask) < t) ? lo + half : lo;
+        len -= half;
+    }
+    return lo + (for_get(p, lo, w, mask) < t);
+}
+
+#if SPEEDUP_X86_64
+/* Narrows to 16 candidates like the scalar loop, then decodes all 16 at once:
+ * each lane gathers the 8 bytes holding its delta and shifts it into place,
+ * which covers widths up to 57 bits. Deltas and t stay below 2^63 there, so
+ * signed compares are exact. */
+SPEEDUP_TARGET_AVX2
+static int64_t block_lower_bound_avx2(const uint64_t* p, int w, int64_t len, uint64_t t) {
+    if (w > 57) return block_lower_bound_scalar(p, w, len, t);
+    uint64_t mask = for_mask(w);
+    if (t > mask) return len;
+
+    int64_t lo = 0;
+    while (len > 16) {
+        int64_t half = len / 2;
+        lo = (for_get(p, lo + half, w, mask) < t) ? lo + half : lo;
+        len -= half;
+    }
+
+    const long long* bytes = (const long long*)p;
+    __m256i vt = _mm256_set1_epi64x((long long)t);
+    __m256i vmask = _mm256_set1_epi64x((long long)mask);
+    __m256i vw = _mm256_set1_epi64x(w);
+    __m256i seven = _mm256_set1_epi64x(7);
+    __m256i idx = _mm256_add_epi64(_mm256_set1_epi64x(lo), _mm256_setr_epi64x(0, 1, 2, 3));
+    __m256i four = _mm256_set1_epi64x(4);
+    uint32_t m = 0;
+    for (int g = 0; g < 4; g++) {
+        __m256i bit = _mm256_mul_epu32(idx, vw);
+        __m256i v = _mm256_i64gather_epi64(bytes, _mm256_srli_epi64(bit, 3), 1);
+        v = _mm256_and_si256(_mm256_srlv_epi64(v, _mm256_and_si256(bit, seven)), vmask);
+        m |= (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(vt, v))) << (4 * g);
+        idx = _mm256_add_epi64(idx, four);
+    }
+    /* Lanes past len decode neighbouring bits; only the first len count. */
+    return lo + speedup_popcount32(m & (((uint32_t)1 << len) - 1));
+}
+#endif
+
+/* Number of block bases < key, with the prefetching branchless loop of
+ * speedup_binary_search_i64_branchless_prefetch (bases are 1/128 of the keys
+ * but still outgrow the caches on large sets). */
+static inline int64_t bases_lower_bound(const int64_t* pairs, int64_t key, int64_t nb) {
+    const int64_t* base = pairs;
+    int64_t len = nb;
+    while (len > 1) {
+        int64_t half = len / 2;
+        int64_t next = (len - half) / 2;
+        SPEEDUP_PREFETCH(base + 2 * next);
+        SPEEDUP_PREFETCH(base + 2 * (half + next));
+        base = (base[2 * half] < key) ? base + 2 * half : base;
+        len -= half;
+    }
+    return (base - pairs) / 2 + (*base < key);
+}
+
+int64_t speedup_index_i64_find_for(const speedup_index_i64_t* index, int64_t key) {
+    const uint64_t* words = (const uint64_t*)index->keys;
+    int64_t n = index->size;
+    int64_t nb = (n + BLOCK - 1) / BLOCK;
+    if (n == 0) return -1;
+
+    /* Last block whose base is < key: the first match starts in it, or is
+     * the base of the next block. */
+    int64_t b = bases_lower_bound(index->keys, key, nb) - 1;
+    if (b < 0) return (int64_t)words[0] == key ? 0 : -1;
+
+    uint64_t base = words[2 * b];
+    uint64_t desc = words[2 * b + 1];
+    const uint64_t* p = words + (desc >> 8);
+    int w = (int)(desc & 0xff);
+    int64_t first = b * BLOCK;
+    int64_t len = n - first < BLOCK ? n - first : BLOCK;
+    uint64_t t = (uint64_t)key - base;
+
+    int64_t i;
+#if SPEEDUP_X86_64
+    if (index->use_avx2) {
+        i = block_lower_bound_avx2(p, w, len, t);
+    } else {
+        i = block_lower_bound_scalar(p, w, len, t);
+    }
+#else
+    i = block_lower_bound_scalar(p, w, len, t);
+#endif
+    if (i < len) return for_get(p, i, w, for_mask(w)) == t ? first + i : -1;
+    return (b + 1 < nb && (int64_t)words[2 * b + 2] == key) ? first + len : -1;
+}
@@ -0,0 +1,105 @@
+#include "speedup/algorithms/binary_search.h"
+#include "core/speedup_internal.h"
+
+/* First pos in [lo, hi) with array[pos] >= key, or hi. */
+static inline int64_t range_lower_bound(const int64_t* array, int64_t lo, int64_t hi, int64_t key) {
+    int64_t len = hi - lo;
+    if (len <= 0) return lo;
+    const int64_t* base = array + lo;
+    while (len > 1) {
+        int64_t half = len / 2;
+        base = (base[half] < key) ? base + half : base;
+        len -= half;
+    }
+    return (base - array) + (*base < key);
+}
+
+/* Slot linear interpolation between the end keys predicts for key, which
+ * must lie in [array[0], array[size - 1]]. */
+static inline int64_t interpolation_guess(const int64_t* array, int64_t key, int64_t size) {
+    if (array[size - 1] <= array[0]) return 0;
+    double frac = ((double)key - (double)array[0]) / ((double)array[size - 1] - (double)array[0]);
+    int64_t guess = (int64_t)(frac * (double)(size - 1));
+    if (guess < 0) guess = 0;
+    if (guess > size - 1) guess = size - 1;
+    return guess;
+}
+
+/* First match of key from a starting guess: an exponential search brackets
+ * the answer around it and a branchless search finishes inside the bracket. */
+static inline int64_t interpolation_finish(const int64_t* array, int64_t key, int64_t size, int64_t guess) {
+    /* Bracket [lo, hi] with array[lo - 1] < key and array[hi] >= key. */
+    int64_t lo, hi, step = 1;
+    if (array[guess] < key) {
+        lo = guess + 1;
+        hi = lo;
+        while (hi < size && array[hi] < key) {
+            lo = hi + 1;
+            hi = lo + step;
+            step *= 2;
+        }
+        if (hi > size) hi = size;
+    } else {
+        hi = guess;
+        lo = guess - 1;
+        while (lo >= 0 && array[lo] >= key) {
+            hi = lo;
+            lo -= step;
+            step *= 2;
+        }
+        lo = lo < 0 ? 0 : lo + 1;
+    }
+
+    int64_t pos = range_lower_bound(array, lo, hi, key);
+    return (pos < size && array[pos] == key) ? pos : -1;
+}
+
+/* Interpolation-guided search: one linear interpolation between the end
+ * keys picks a starting point, an exponential search brackets the answer
+ * around it, and a branchless search finishes inside the bracket. On
+ * near-uniform keys the guess is within a few slots, so a lookup is a couple
+ * of dependent loads instead of log2(size). On skewed keys the gallop and
+ * the final search each take at most log2(size) probes, so the worst case
+ * stays within about twice a binary search. */
+int64_t speedup_binary_search_i64_interpolation(const int64_t* array, int64_t key, int64_t size) {
+    if (size <= 0 || key < array[0] || key > array[size - 1]) return -1;
+    return interpolation_finish(array, key, size, interpolation_guess(array, key, size));
+}
+
+/* Keys whose guesses are prefetched before any of them is finished, as in
+ * the group-prefetching batch kernels. */
+#define SPEEDUP_INTERP_BATCH_GROUP 16
+
+void speedup_binary_search_i64_batch_interpolation(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out) {
+    int64_t guess[SPEEDUP_INTERP_BATCH_GROUP];
+    for (int64_t i = 0; i < n; i += SPEEDUP_INTERP_BATCH_GROUP) {
+        int64_t m = n - i < SPEEDUP_INTERP_BATCH_GROUP ? n - i : SPEEDUP_INTERP_BATCH_GROUP;
+        for (int64_t j = 0; j < m; j++) {
+            int64_t key = keys[i + j];
+            guess[j] = (size <= 0 || key < array[0] || key > array[size - 1]) ? -1 : interpolation_guess(array, key, size);
+            if (guess[j] >= 0) SPEEDUP_PREFETCH(array + guess[j]);
+        }
+        for (int64_t j = 0; j < m; j++) {
+            out[i + j] = guess[j] < 0 ? -1 : interpolation_finish(array, keys[i + j], size, guess[j]);
+        }
+    }
+}
+
+/* Positions checked by the uniformity test, and the largest distance (in
+ * elements) allowed between a sample's index and the index interpolation
+ * predicts for its key. */
+#define SPEEDUP_UNIFORM_SAMPLES 32
+#define SPEEDUP_UNIFORM_MAX_ERROR 32.0
+
+int speedup_keys_uniform_i64(const int64_t* array, int64_t size) {
+    if (size < 2 || array[size - 1] <= array[0]) return 0;
+
+    double first = (double)array[0];
+    double scale = (double)(size - 1) / ((double)array[size - 1] - first);
+    for (int s = 1; s < SPEEDUP_UNIFORM_SAMPLES; s++) {
+        int64_t p = (int64_t)((double)(size - 1) * s / SPEEDUP_UNIFORM_SAMPLES);
+        double error = ((double)array[p] - first) * scale - (double)p;
+        if (error > SPEEDUP_UNIFORM_MAX_ERROR || error < -SPEEDUP_UNIFORM_MAX_ERROR) return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,180 @@
+#include <stdatomic.h>
+#include "speedup/algorithms/intersect.h"
+#include "speedup/algorithms/binary_search.h"
+#include "speedup/backend/cpu_features.h"
+#include "core/speedup_internal.h"
+
+#if SPEEDUP_X86_64
+#include <immintrin.h>
+#endif
+
+/* Where matches go; any pointer may be NULL. Writes are unconditional (the
+ * slot past the last match is overwritten by the next one), which keeps the
+ * merge loop free of data-dependent branches. While both inputs have
+ * elements left, fewer than min(a_size, b_size) matches have been written,
+ * so the slot is always in bounds. */
+typedef struct intersect_out_t {
+    int64_t* values;
+    int64_t* a_pos;
+    int64_t* b_pos;
+} intersect_out_t;
+
+static inline void emit(const intersect_out_t* out, int64_t n, int64_t value, int64_t i, int64_t j) {
+    if (out->values) out->values[n] = value;
+    if (out->a_pos) out->a_pos[n] = i;
+    if (out->b_pos) out->b_pos[n] = j;
+}
+
+/* Branchless merge steps from (*i, *j) until either index reaches its end. */
+static inline int64_t merge_scalar(const int64_t* a, int64_t a_end, const int64_t* b, int64_t b_end,
+                                   int64_t* i, int64_t* j, int64_t n, const intersect_out_t* out) {
+    int64_t x = *i;
+    int64_t y = *j;
+    while (x < a_end && y < b_end) {
+        int64_t va = a[x];
+        int64_t vb = b[y];
+        emit(out, n, va, x, y);
+        n += va == vb;
+        x += va <= vb;
+        y += vb <= va;
+    }
+    *i = x;
+    *j = y;
+    return n;
+}
+
+static int64_t merge_portable(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size, const intersect_out_t* out) {
+    int64_t i = 0;
+    int64_t j = 0;
+    return merge_scalar(a, a_size, b, b_size, &i, &j, 0, out);
+}
+
+#if SPEEDUP_X86_64
+/* Blocks of 4 from each side are compared all-against-all (the b block in
+ * its 4 rotations). Without an equal pair, the block with the smaller last
+ * element cannot match anything further on and is skipped whole; with one,
+ * scalar steps resolve the pair exactly (duplicates included) until a block
+ * is used up. */
+SPEEDUP_TARGET_AVX2
+static int64_t merge_avx2(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size, const intersect_out_t* out) {
+    int64_t i = 0;
+    int64_t j = 0;
+    int64_t n = 0;
+    while (i + 4 <= a_size && j + 4 <= b_size) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + j));
+        __m256i eq = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi64(va, vb),
+                            _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm256_or_si256(_mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                            _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        if (_mm256_testz_si256(eq, eq)) {
+            int64_t a_last = a[i + 3];
+            int64_t b_last = b[j + 3];
+            i += (a_last <= b_last) * 4;
+            j += (b_last <= a_last) * 4;
+            continue;
+        }
+        n = merge_scalar(a, i + 4, b, j + 4, &i, &j, n, out);
+    }
+    return merge_scalar(a, a_size, b, b_size, &i, &j, n, out);
+}
+#endif
+
+typedef int64_t (*merge_fn)(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size, const intersect_out_t* out);
+
+static int64_t merge_resolve(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size, const intersect_out_t* out);
+static _Atomic(merge_fn) merge_kernel = merge_resolve;
+
+/* First call picks the kernel. Concurrent first calls pick the same one; the
+ * atomic pointer keeps their stores from racing with other callers' loads. */
+static int64_t merge_resolve(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size, const intersect_out_t* out) {
+#if SPEEDUP_X86_64
+    merge_fn fn = speedup_cpu_has_avx2() ? merge_avx2 : merge_portable;
+#else
+    merge_fn fn = merge_portable;
+#endif
+    atomic_store_explicit(&merge_kernel, fn, memory_order_relaxed);
+    return fn(a, a_size, b, b_size, out);
+}
+
+/* Keys of small searched at a time, SPEEDUP_INLINE_BATCH_GROUP of them in flight. */
+#define SEARCH_CHUNK 64
+
+/* Every element of small is looked up in large with the group-prefetching
+ * speedup_lower_bound_i64_batch_interleaved, a chunk of keys per call over
+ * the part of large past the previous chunk's last match. Searching from the
+ * chunk start instead of from each key's predecessor costs a few probes on
+ * cached upper levels but keeps many misses in flight, which is what makes
+ * skewed sizes cheap; exponential galloping from each match was slower at
+ * every ratio measured. The lower bound from the running position is the
+ * larger of the two, which also pairs duplicates in order. swapped says
+ * small is b, so positions are written back the right way round. */
+static int64_t search(const int64_t* small, int64_t small_size, const int64_t* large, int64_t large_size,
+                      int swapped, const intersect_out_t* out) {
+    int64_t lower[SEARCH_CHUNK];
+    int64_t n = 0;
+    int64_t pos = 0;
+    for (int64_t c = 0; c < small_size; c += SEARCH_CHUNK) {
+        int64_t m = small_size - c < SEARCH_CHUNK ? small_size - c : SEARCH_CHUNK;
+        int64_t start = pos;
+        speedup_lower_bound_i64_batch_interleaved(large + start, large_size - start, small + c, m, lower);
+        for (int64_t k = 0; k < m; k++) {
+            int64_t p = start + lower[k];
+            if (p < pos) p = pos;
+            if (p == large_size) return n;
+            pos = p;
+            if (large[p] == small[c + k]) {
+                if (swapped) {
+                    emit(out, n, small[c + k], p, c + k);
+                } else {
+                    emit(out, n, small[c + k], c + k, p);
+                }
+                n++;
+                pos++;
+            }
+        }
+    }
+    return n;
+}
+
+static int64_t intersect_search(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size, const intersect_out_t* out) {
+    if (a_size <= b_size) return search(a, a_size, b, b_size, 0, out);
+    return search(b, b_size, a, a_size, 1, out);
+}
+
+static int64_t intersect(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size, const intersect_out_t* out) {
+    if (a_size <= 0 || b_size <= 0) return 0;
+    int64_t small = a_size < b_size ? a_size : b_size;
+    int64_t large = a_size < b_size ? b_size : a_size;
+    if (large / small > SPEEDUP_INTERSECT_SEARCH_RATIO) return intersect_search(a, a_size, b, b_size, out);
+    return atomic_load_explicit(&merge_kernel, memory_order_relaxed)(a, a_size, b, b_size, out);
+}
+
+int64_t speedup_intersect_i64(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size, int64_t* out) {
+    intersect_out_t o = {out, NULL, NULL};
+    return intersect(a, a_size, b, b_size, &o);
+}
+
+int64_t speedup_intersect_i64_positions(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size,
+                                        int64_t* a_pos, int64_t* b_pos) {
+    intersect_out_t o = {NULL, a_pos, b_pos};
+    return intersect(a, a_size, b, b_size, &o);
+}
+
+int64_t speedup_intersect_i64_count(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size) {
+    intersect_out_t o = {NULL, NULL, NULL};
+    return intersect(a, a_size, b, b_size, &o);
+}
+
+int64_t speedup_intersect_i64_count_merge(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size) {
+    intersect_out_t o = {NULL, NULL, NULL};
+    if (a_size <= 0 || b_size <= 0) return 0;
+    return atomic_load_explicit(&merge_kernel, memory_order_relaxed)(a, a_size, b, b_size, &o);
+}
+
+int64_t speedup_intersect_i64_count_search(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size) {
+    intersect_out_t o = {NULL, NULL, NULL};
+    if (a_size <= 0 || b_size <= 0) return 0;
+    return intersect_search(a, a_size, b, b_size, &o);
+}
@@ -0,0 +1,175 @@
+#include <math.h>
+#include <string.h>
+#include "index_internal.h"
+#include "core/speedup_internal.h"
+#include "speedup/backend/memory.h"
+#include "speedup/algorithms/binary_search.h"
+
+/* Learned index in the style of the PGM-index: level 0 is a list of linear
+ * segments mapping a key to its sorted position within +-epsilon, and each
+ * level above fits the first keys of the level below the same way (with a
+ * small fixed epsilon) until one segment is left. A lookup evaluates one
+ * segment per level, scans a few neighbouring segment keys to pick the next
+ * one, and finishes with a branchless search over 2 * epsilon + 3 keys, so
+ * only the last step touches the key array. */
+
+#define SPEEDUP_PGM_INTERNAL_EPSILON 8
+
+/* Segments are fitted with a shrinking cone: anchored at their first point,
+ * they keep the range of slopes that leaves every point so far within
+ * epsilon, and close when the range becomes empty. Slopes are clamped at 0
+ * so predictions never decrease with the key. */
+typedef struct pgm_builder_t {
+    speedup_pgm_segment_t* segments;
+    int64_t count;
+    int64_t capacity;
+    double epsilon;
+    int64_t x0;
+    int64_t y0;
+    double slope_lo;
+    double slope_hi;
+    int open;
+} pgm_builder_t;
+
+static int pgm_emit(pgm_builder_t* b) {
+    if (b->count == b->capacity) {
+        int64_t capacity = b->capacity ? b->capacity * 2 : 64;
+        speedup_pgm_segment_t* grown = (speedup_pgm_segment_t*)realloc(b->segments, (size_t)capacity * sizeof(*grown));
+        if (!grown) return 0;
+        b->segments = grown;
+        b->capacity = capacity;
+    }
+    speedup_pgm_segment_t* s = &b->segments[b->count++];
+    s->key = b->x0;
+    s->intercept = b->y0;
+    s->slope = b->slope_hi == HUGE_VAL ? 0.0 : (b->slope_lo + b->slope_hi) / 2;
+    return 1;
+}
+
+static int pgm_add(pgm_builder_t* b, int64_t x, int64_t y) {
+    if (b->open) {
+        double dx = (double)((uint64_t)x - (uint64_t)b->x0);
+        double lo = ((double)(y - b->y0) - b->epsilon) / dx;
+        double hi = ((double)(y - b->y0) + b->epsilon) / dx;
+        if (lo <= b->slope_hi && hi >= b->slope_lo) {
+            if (lo > b->slope_lo) b->slope_lo = lo;
+            if (hi < b->slope_hi) b->slope_hi = hi;
+            return 1;
+        }
+        if (!pgm_emit(b)) return 0;
+    }
+    b->open = 1;
+    b->x0 = x;
+    b->y0 = y;
+    b->slope_lo = 0.0;
+    b->slope_hi = HUGE_VAL;
+    return 1;
+}
+
+static int pgm_finish(pgm_builder_t* b) {
+    return !b->open || pgm_emit(b);
+}
+
+/* Predicted position of key (>= s->key), clamped to [0, limit]. */
+static inline int64_t pgm_predict(const speedup_pgm_segment_t* s, int64_t key, int64_t limit) {
+    double pos = (double)s->intercept + s->slope * (double)((uint64_t)key - (uint64_t)s->key);
+    if (pos < 0) return 0;
+    if (pos > (double)limit) return limit;
+    return (int64_t)pos;
+}
+
+int speedup_index_i64_init_pgm(speedup_index_i64_t* index, const int64_t* sorted, int64_t epsilon) {
+    int64_t n = index->size;
+    index->epsilon = epsilon;
+    index->keys = (int64_t*)speedup_alloc((size_t)n * sizeof(int64_t));
+    if (!index->keys) return 0;
+    if (n > 0) memcpy(index->keys, sorted, (size_t)n * sizeof(int64_t));
+
+    /* Level 0 maps each distinct key to its first position. */
+    speedup_pgm_segment_t* levels[SPEEDUP_INDEX_MAX_LAYERS];
+    int64_t counts[SPEEDUP_INDEX_MAX_LAYERS];
+    int height = 0;
+    int ok = 1;
+
+    pgm_builder_t b;
+    memset(&b, 0, sizeof(b));
+    b.epsilon = (double)epsilon;
+    for (int64_t i = 0; i < n && ok; i++) {
+        if (i == 0 || sorted[i] != sorted[i - 1]) ok = pgm_add(&b, sorted[i], i);
+    }
+    ok = ok && pgm_finish(&b);
+    levels[height] = b.segments;
+    counts[height++] = b.count;
+
+    while (ok && counts[height - 1] > 1) {
+        if (height == SPEEDUP_INDEX_MAX_LAYERS) {
+            ok = 0;
+            break;
+        }
+        const speedup_pgm_segment_t* below = levels[height - 1];
+        memset(&b, 0, sizeof(b));
+        b.epsilon = SPEEDUP_PGM_INTERNAL_EPSILON;
+        for (int64_t j = 0; j < counts[height - 1] && ok; j++) ok = pgm_add(&b, below[j].key, j);
+        ok = ok && pgm_finish(&b);
+        levels[height] = b.segments;
+        counts[height++] = b.count;
+    }
+
+    /* Pack all levels into one allocation, level 0 first. */
+    if (ok) {
+        index->layer_offset[0] = 0;
+        for (int h = 0; h < height; h++) index->layer_offset[h + 1] = index->layer_offset[h] + counts[h];
+        size_t bytes = (size_t)index->layer_offset[height] * sizeof(speedup_pgm_segment_t);
+        index->segments = (speedup_pgm_segment_t*)speedup_alloc(bytes);
+        ok = index->segments != NULL;
+        for (int h = 0; ok && h < height; h++) {
+            if (counts[h] > 0) {
+                memcpy(index->segments + index->layer_offset[h], levels[h], (size_t)counts[h] * sizeof(speedup_pgm_segment_t));
+            }
+        }
+        index->height = height;
+    }
+    for (int h = 0; h < height; h++) free(levels[h]);
+    return ok;
+}
+
+/* Keys past a segment's last point extrapolate its line, so predictions are
+ * capped at the next segment's first position (as in the PGM-index). */
+static inline int64_t pgm_limit(const speedup_pgm_segment_t* level, int64_t j, int64_t count, int64_t last) {
+    return j + 1 < count ? level[j + 1].intercept : last;
+}
+
+int64_t speedup_index_i64_find_pgm(const speedup_index_i64_t* index, int64_t key) {
+    const int64_t* keys = index->keys;
+    int64_t n = index->size;
+    if (n == 0 || key < keys[0] || key > keys[n - 1]) return -1;
+
+    int h = index->height - 1;
+    const speedup_pgm_segment_t* level = index->segments + index->layer_offset[h];
+    int64_t j = 0;
+    for (; h > 0; h--) {
+        const speedup_pgm_segment_t* below = index->segments + index->layer_offset[h - 1];
+        int64_t count = index->layer_offset[h] - index->layer_offset[h - 1];
+        int64_t level_count = index->layer_offset[h + 1] - index->layer_offset[h];
+        int64_t pos = pgm_predict(&level[j], key, pgm_limit(level, j, level_count, count - 1));
+
+        /* Last segment starting at or before key; the window holds it. */
+        int64_t lo = pos - SPEEDUP_PGM_INTERNAL_EPSILON - 1;
+        int64_t hi = pos + SPEEDUP_PGM_INTERNAL_EPSILON + 2;
+        if (lo < 0) lo = 0;
+        if (hi > count) hi = count;
+        j = lo;
+        for (int64_t i = lo + 1; i < hi; i++) j += below[i].key <= key;
+        level = below;
+    }
+
+    /* +1 on each side absorbs floating-point rounding in the prediction. */
+    int64_t leaf_count = index->layer_offset[1];
+    int64_t pos = pgm_predict(&level[j], key, pgm_limit(level, j, leaf_count, n - 1));
+    int64_t lo = pos - index->epsilon - 1;
+    int64_t hi = pos + index->epsilon + 2;
+    if (lo < 0) lo = 0;
+    if (hi > n) hi = n;
+    int64_t r = lo + speedup_lower_bound_i64_branchless(keys + lo, key, hi - lo);
+    return (r < n && keys[r] == key) ? r : -1;
+}
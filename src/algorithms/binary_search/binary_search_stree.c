@@ -0,0 +1,98 @@
+#include "index_internal.h"
+#include "core/speedup_internal.h"
+#include "speedup/backend/memory.h"
+#include "speedup/backend/cpu_features.h"
+
+#include "speedup/algorithms/search_inline.h"
+
+/* Static B+-tree ("S-tree"): every node holds B = 16 keys in two cache lines
+ * and has B + 1 implicit children, so a lookup touches about log17(N) nodes.
+ * Layers are stored leaves first; the leaf layer is the sorted array itself,
+ * padded with INT64_MAX, which makes the leaf offset the sorted position.
+ * Internal key j of a node is the smallest key of child j + 1. */
+
+#define B SPEEDUP_STREE_B
+
+static int64_t stree_blocks(int64_t n) {
+    return (n + B - 1) / B;
+}
+
+static int64_t stree_prev_keys(int64_t n) {
+    return (stree_blocks(n) + B) / (B + 1) * B;
+}
+
+int speedup_index_i64_init_stree(speedup_index_i64_t* index, const int64_t* sorted) {
+    int64_t n = index->size;
+
+    int height = 1;
+    index->layer_offset[0] = 0;
+    for (int64_t m = n;; m = stree_prev_keys(m)) {
+        int64_t layer = stree_blocks(m) > 0 ? stree_blocks(m) * B : B;
+        index->layer_offset[height] = index->layer_offset[height - 1] + layer;
+        if (m <= B) break;
+        if (++height > SPEEDUP_STREE_MAX_HEIGHT) return 0;
+    }
+    index->height = height;
+
+    int64_t total = index->layer_offset[height];
+    index->keys = (int64_t*)speedup_alloc((size_t)total * sizeof(int64_t));
+    if (!index->keys) return 0;
+
+    int64_t* keys = index->keys;
+    for (int64_t i = 0; i < n; i++) keys[i] = sorted[i];
+    for (int64_t i = n; i < total; i++) keys[i] = INT64_MAX;
+
+    for (int h = 1; h < height; h++) {
+        int64_t count = index->layer_offset[h + 1] - index->layer_offset[h];
+        for (int64_t i = 0; i < count; i++) {
+            /* Step right of key i once, then follow leftmost children down. */
+            int64_t k = i / B * (B + 1) + i % B + 1;
+            for (int l = 1; l < h; l++) k *= B + 1;
+            keys[index->layer_offset[h] + i] = k * B < n ? keys[k * B] : INT64_MAX;
+        }
+    }
+
+    index->use_avx2 = SPEEDUP_X86_64 && speedup_cpu_has_avx2();
+    return 1;
+}
+
+/* Node ranks come from speedup/algorithms/search_inline.h, shared with the
+ * C++ API; the AVX2 form is picked at run time here. */
+static int64_t stree_lower_bound_scalar(const speedup_index_i64_t* index, int64_t key) {
+    const int64_t* keys = index->keys;
+    int64_t k = 0;
+    for (int h = index->height - 1; h > 0; h--) {
+        int64_t i = speedup_stree_rank_i64_scalar_inline(keys + index->layer_offset[h] + k, key);
+        k = k * (B + 1) + i * B;
+    }
+    return k + speedup_stree_rank_i64_scalar_inline(keys + k, key);
+}
+
+#if defined(SPEEDUP_INLINE_AVX2)
+SPEEDUP_TARGET_AVX2
+static int64_t stree_lower_bound_avx2(const speedup_index_i64_t* index, int64_t key) {
+    /* Nodes are 128-byte aligned. */
+    const int64_t* keys = index->keys;
+    int64_t k = 0;
+    for (int h = index->height - 1; h > 0; h--) {
+        int64_t i = speedup_stree_rank_i64_avx2_inline(keys + index->layer_offset[h] + k, key);
+        k = k * (B + 1) + i * B;
+    }
+    return k + speedup_stree_rank_i64_avx2_inline(keys + k, key);
+}
+#endif
+
+int64_t speedup_index_i64_find_stree(const speedup_index_i64_t* index, int64_t key) {
+    int64_t pos;
+#if defined(SPEEDUP_INLINE_AVX2)
+    if (index->use_avx2) {
+        pos = stree_lower_bound_avx2(index, key);
+    } else {
+        pos = stree_lower_bound_scalar(index, key);
+    }
+#else
+    pos = stree_lower_bound_scalar(index, key);
+#endif
+    if (pos >= index->size || index->keys[pos] != key) return -1;
+    return pos;
+}
@@ -0,0 +1,72 @@
+#include <string.h>
+#include "speedup/algorithms/binary_search.h"
+#include "speedup/algorithms/index.h"
+#include "core/speedup_internal.h"
+
+/* Key of record i. memcpy keeps packed or misaligned records legal and
+ * compiles to a single load. */
+static inline int64_t record_key(const char* keys, size_t stride, int64_t i) {
+    int64_t key;
+    memcpy(&key, keys + (size_t)i * stride, sizeof(key));
+    return key;
+}
+
+/* Half-open bisection on the record keys, then one equality check, so the
+ * first of equal keys is returned. */
+int64_t speedup_binary_search_i64_strided_ref(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size) {
+    const char* keys = (const char*)base + key_offset;
+    int64_t lo = 0;
+    int64_t hi = size > 0 ? size : 0;
+    while (lo < hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (record_key(keys, stride, mid) < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo < size && record_key(keys, stride, lo) == key) ? lo : -1;
+}
+
+/* The CMOV loop of speedup_lower_bound_i64_branchless with a byte stride:
+ * the index is carried instead of a pointer, so the only multiply per step is
+ * the address computation. With records, every probe misses on its own cache
+ * line, so both possible next probes are prefetched as in
+ * speedup_binary_search_i64_branchless_prefetch. */
+int64_t speedup_lower_bound_i64_strided(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size) {
+    if (size <= 0) return 0;
+    const char* keys = (const char*)base + key_offset;
+    int64_t lo = 0;
+    int64_t len = size;
+    while (len > 1) {
+        int64_t half = len / 2;
+        int64_t next = (len - half) / 2;
+        SPEEDUP_PREFETCH(keys + (size_t)(lo + next) * stride);
+        SPEEDUP_PREFETCH(keys + (size_t)(lo + half + next) * stride);
+        lo = (record_key(keys, stride, lo + half) < key) ? lo + half : lo;
+        len -= half;
+    }
+    return lo + (record_key(keys, stride, lo) < key);
+}
+
+int64_t speedup_binary_search_i64_strided_branchless(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size) {
+    int64_t pos = speedup_lower_bound_i64_strided(base, stride, key_offset, key, size);
+    const char* keys = (const char*)base + key_offset;
+    return (pos < size && record_key(keys, stride, pos) == key) ? pos : -1;
+}
+
+void speedup_keys_gather_i64(const void* base, size_t stride, size_t key_offset, int64_t size, int64_t* out) {
+    const char* keys = (const char*)base + key_offset;
+    for (int64_t i = 0; i < size; i++) out[i] = record_key(keys, stride, i);
+}
+
+speedup_index_i64_t* speedup_index_i64_build_records(speedup_index_layout_t layout, const void* base, size_t stride,
+                                                     size_t key_offset, int64_t size) {
+    if (size < 0) return NULL;
+    int64_t* keys = (int64_t*)malloc((size_t)(size > 0 ? size : 1) * sizeof(int64_t));
+    if (!keys) return NULL;
+    speedup_keys_gather_i64(base, stride, key_offset, size, keys);
+    speedup_index_i64_t* index = speedup_index_i64_build(layout, keys, size);
+    free(keys);
+    return index;
+}
@@ -0,0 +1,256 @@
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "speedup/backend/tuning.h"
+#include "kernel_table.h"
+#include "core/speedup_internal.h"
+#include "speedup/backend/memory.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define SPEEDUP_TUNING_MAX_BANDS 16
+#define SPEEDUP_TUNING_MIN_SIZE 1024
+#define SPEEDUP_TUNING_KEYS 4096
+#define SPEEDUP_TUNING_PASSES 5
+#define SPEEDUP_TUNING_MAGIC "speedup-tuning 1"
+
+/* Band i covers sizes in (bands[i - 1].max_size, bands[i].max_size]; the last
+ * band always ends at INT64_MAX. */
+typedef struct speedup_tuning_band_t {
+    int64_t max_size;
+    const speedup_kernel_info_t* kernel;
+} speedup_tuning_band_t;
+
+/* An installed profile. Tables are immutable once published: a reload
+ * publishes a new one and searches already walking the old one finish on it.
+ * Retired tables stay linked from g_retired and are never freed, since
+ * readers take no reference; each is a few hundred bytes, one per reload. */
+typedef struct speedup_tuning_table_t {
+    struct speedup_tuning_table_t* retired;
+    int count;
+    speedup_tuning_band_t bands[SPEEDUP_TUNING_MAX_BANDS];
+} speedup_tuning_table_t;
+
+static _Atomic(const speedup_tuning_table_t*) g_table = NULL;
+static _Atomic(speedup_tuning_table_t*) g_retired = NULL;
+
+static inline const speedup_tuning_table_t* current_table(void) {
+    return atomic_load_explicit(&g_table, memory_order_acquire);
+}
+
+/* Loads the table once per call. A reset can land between a caller loading
+ * this kernel and the kernel table being re-resolved, so no table means the
+ * untuned default. */
+static int64_t speedup_search_i64_tuned(const int64_t* array, int64_t key, int64_t size) {
+    const speedup_tuning_table_t* table = current_table();
+    if (!table) return speedup_kernel_default()->search_i64(array, key, size);
+    const speedup_tuning_band_t* band = table->bands;
+    while (size > band->max_size) band++;
+    return band->kernel->search_i64(array, key, size);
+}
+
+speedup_search_i64_fn speedup_tuning_search_i64(void) {
+    const speedup_tuning_table_t* table = current_table();
+    if (!table) return NULL;
+    if (table->count == 1) return table->bands[0].kernel->search_i64;
+    return speedup_search_i64_tuned;
+}
+
+/* Publishes table (or NULL) and retires the one it replaces. */
+static void publish(const speedup_tuning_table_t* table) {
+    speedup_tuning_table_t* old =
+        (speedup_tuning_table_t*)atomic_exchange_explicit(&g_table, table, memory_order_acq_rel);
+    if (old) {
+        old->retired = atomic_load_explicit(&g_retired, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&g_retired, &old->retired, old, memory_order_release,
+                                                      memory_order_relaxed)) {
+        }
+    }
+    speedup_kernels_resolve();
+}
+
+/* Installs bands (merging neighbours that chose the same kernel). */
+static int install(const speedup_tuning_band_t* bands, int count) {
+    speedup_tuning_table_t* table = (speedup_tuning_table_t*)malloc(sizeof(*table));
+    if (!table) return -1;
+    int out = 0;
+    for (int i = 0; i < count; i++) {
+        if (out > 0 && table->bands[out - 1].kernel == bands[i].kernel) {
+            table->bands[out - 1].max_size = bands[i].max_size;
+        } else {
+            table->bands[out++] = bands[i];
+        }
+    }
+    if (out > 0) table->bands[out - 1].max_size = INT64_MAX;
+    table->count = out;
+    table->retired = NULL;
+    publish(table);
+    return 0;
+}
+
+void speedup_tuning_reset(void) {
+    publish(NULL);
+}
+
+const char* speedup_tuning_kernel_for_size(int64_t size) {
+    const speedup_tuning_table_t* table = current_table();
+    if (!table) return speedup_kernel_default()->name;
+    const speedup_tuning_band_t* band = table->bands;
+    while (size > band->max_size) band++;
+    return band->kernel->name;
+}
+
+static double now_ns(void) {
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency = {0};
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1e9 / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+static double measure(speedup_search_i64_fn fn, const int64_t* array, int64_t size, const int64_t* keys) {
+    volatile int64_t sink = 0;
+    int64_t acc = 0;
+    for (int k = 0; k < SPEEDUP_TUNING_KEYS; k++) acc += fn(array, keys[k], size);
+
+    double best = 0;
+    for (int pass = 0; pass < SPEEDUP_TUNING_PASSES; pass++) {
+        double start = now_ns();
+        for (int k = 0; k < SPEEDUP_TUNING_KEYS; k++) acc += fn(array, keys[k], size);
+        double elapsed = now_ns() - start;
+        if (pass == 0 || elapsed < best) best = elapsed;
+    }
+    sink = acc;
+    (void)sink;
+    return best / SPEEDUP_TUNING_KEYS;
+}
+
+int speedup_calibrate(int64_t max_size) {
+    int kernels = speedup_kernel_count();
+    if (kernels == 0) return -1;
+    if (max_size < SPEEDUP_TUNING_MIN_SIZE) max_size = SPEEDUP_TUNING_MIN_SIZE;
+
+    int64_t* array = (int64_t*)speedup_alloc((size_t)max_size * sizeof(int64_t));
+    int64_t* keys = (int64_t*)malloc(SPEEDUP_TUNING_KEYS * sizeof(int64_t));
+    if (!array || !keys) {
+        speedup_free(array);
+        free(keys);
+        return -1;
+    }
+    for (int64_t i = 0; i < max_size; i++) array[i] = i * 2;
+
+    speedup_tuning_band_t bands[SPEEDUP_TUNING_MAX_BANDS];
+    int count = 0;
+    uint64_t rng = 0x9e3779b97f4a7c15ull;
+
+    for (int64_t size = SPEEDUP_TUNING_MIN_SIZE; count < SPEEDUP_TUNING_MAX_BANDS; size *= 4) {
+        if (size > max_size || count == SPEEDUP_TUNING_MAX_BANDS - 1) size = max_size;
+
+        for (int k = 0; k < SPEEDUP_TUNING_KEYS; k++) {
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            keys[k] = (int64_t)(rng % (uint64_t)(2 * size));  /* hits and misses */
+        }
+
+        const speedup_kernel_info_t* winner = NULL;
+        double best = 0;
+        for (int i = 0; i < kernels; i++) {
+            const speedup_kernel_info_t* kernel = speedup_kernel_get(i);
+            if (!speedup_kernel_calibrated(kernel)) continue;
+            double ns = measure(kernel->search_i64, array, size, keys);
+            if (!winner || ns < best) {
+                winner = kernel;
+                best = ns;
+            }
+        }
+        bands[count].max_size = size;
+        bands[count].kernel = winner;
+        count++;
+
+        if (size == max_size) break;
+    }
+
+    speedup_free(array);
+    free(keys);
+    return install(bands, count);
+}
+
+/* Written through a temp file and renamed into place, so a process loading
+ * the profile while another saves it sees the old file or the new one, never
+ * a partial one. */
+int speedup_tuning_save(const char* path) {
+    char* tmp = NULL;
+    FILE* f = speedup_file_create_temp(path, &tmp);
+    if (!f) return -1;
+
+    const speedup_tuning_table_t* table = current_table();
+    int ok = fprintf(f, "%s\n", SPEEDUP_TUNING_MAGIC) > 0;
+    for (int i = 0; ok && table && i < table->count; i++) {
+        const speedup_tuning_band_t* band = &table->bands[i];
+        if (band->max_size == INT64_MAX) {
+            ok = fprintf(f, "max %s\n", band->kernel->name) > 0;
+        } else {
+            ok = fprintf(f, "%lld %s\n", (long long)band->max_size, band->kernel->name) > 0;
+        }
+    }
+    return speedup_file_commit_temp(f, tmp, path, ok);
+}
+
+int speedup_tuning_load(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+
+    char line[128];
+    if (!fgets(line, sizeof(line), f) || strncmp(line, SPEEDUP_TUNING_MAGIC, strlen(SPEEDUP_TUNING_MAGIC)) != 0) {
+        fclose(f);
+        return -1;
+    }
+
+    /* Profiles naming a kernel this host cannot run are rejected whole, so a
+     * profile copied from another machine never half-applies. */
+    speedup_tuning_band_t bands[SPEEDUP_TUNING_MAX_BANDS];
+    int count = 0;
+    int ok = 1;
+    while (ok && fgets(line, sizeof(line), f)) {
+        char size_text[32], name[64];
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (count == SPEEDUP_TUNING_MAX_BANDS || sscanf(line, "%31s %63s", size_text, name) != 2) {
+            ok = 0;
+            break;
+        }
+
+        int64_t size = INT64_MAX;
+        if (strcmp(size_text, "max") != 0) {
+            char* end;
+            size = strtoll(size_text, &end, 10);
+            if (*end != '\0' || size == INT64_MAX) size = 0;  /* trailing junk, or "max" spelled out */
+        }
+        const speedup_kernel_info_t* kernel = speedup_kernel_find(name);
+        if (!kernel || size <= 0 || (count > 0 && size <= bands[count - 1].max_size)) {
+            ok = 0;
+            break;
+        }
+        bands[count].max_size = size;
+        bands[count].kernel = kernel;
+        count++;
+    }
+    fclose(f);
+
+    /* A profile ends with its "max" band; one without it was cut short. */
+    if (!ok || count == 0 || bands[count - 1].max_size != INT64_MAX) return -1;
+    return install(bands, count);
+}
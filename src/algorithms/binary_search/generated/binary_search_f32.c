@@ -0,0 +1,84 @@
+/* Generated by codegen/generate_specializations.py from codegen/types.yaml. Do not edit. */
+#include <stdatomic.h>
+#include "speedup/algorithms/binary_search_typed.h"
+#include "speedup/backend/cpu_features.h"
+#include "core/speedup_internal.h"
+
+#if SPEEDUP_X86_64
+#include <immintrin.h>
+#endif
+
+typedef int64_t (*search_f32_fn)(const float* array, float key, int64_t size);
+
+int64_t speedup_binary_search_f32_branchless(const float* array, float key, int64_t size) {
+    if (size <= 0) return -1;
+
+    const float* base = array;
+    int64_t len = size;
+    while (len > 1) {
+        int64_t half = len / 2;
+        base = (base[half] < key) ? base + half : base;
+        len -= half;
+    }
+
+    int64_t pos = (base - array) + (*base < key);
+    return (pos < size && array[pos] == key) ? pos : -1;
+}
+
+#if SPEEDUP_X86_64
+/* 32 keys = 128 bytes = 4 vectors of 8 lanes. */
+#define WINDOW 32
+
+/* Branchless descent until at most WINDOW candidates remain, then count the
+ * keys < key in a WINDOW-wide block covering them. The block is moved left
+ * to stay inside the array; keys left of the descent base are all < key, so
+ * the count still lands on the lower bound. */
+SPEEDUP_TARGET_AVX2
+static int64_t search_f32_avx2(const float* array, float key, int64_t size) {
+    if (size < WINDOW) return speedup_binary_search_f32_branchless(array, key, size);
+
+    const float* base = array;
+    int64_t len = size;
+    while (len > WINDOW) {
+        int64_t half = len / 2;
+        base = (base[half] < key) ? base + half : base;
+        len -= half;
+    }
+    const float* start = (base + WINDOW <= array + size) ? base : array + size - WINDOW;
+
+    const __m256 x = _mm256_set1_ps(key);
+    int count = 0;
+    for (int i = 0; i < WINDOW; i += 8) {
+        const __m256 v = _mm256_loadu_ps(start + i);
+        count += speedup_popcount32((uint32_t)_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(v, x, _CMP_LT_OQ))));
+    }
+
+    int64_t pos = (start - array) + (count >> 2);
+    return (pos < size && array[pos] == key) ? pos : -1;
+}
+
+#undef WINDOW
+#endif
+
+static int64_t search_f32_resolve(const float* array, float key, int64_t size);
+static _Atomic(search_f32_fn) search_f32_impl = search_f32_resolve;
+
+/* Picks the kernel on first call. Racing first callers pick the same one;
+ * the pointer is atomic so their stores never race with other readers. */
+static int64_t search_f32_resolve(const float* array, float key, int64_t size) {
+#if SPEEDUP_X86_64
+    search_f32_fn fn = speedup_cpu_has_avx2() ? search_f32_avx2 : speedup_binary_search_f32_branchless;
+#else
+    search_f32_fn fn = speedup_binary_search_f32_branchless;
+#endif
+    atomic_store_explicit(&search_f32_impl, fn, memory_order_relaxed);
+    return fn(array, key, size);
+}
+
+int64_t speedup_binary_search_f32_simd(const float* array, float key, int64_t size) {
+    return atomic_load_explicit(&search_f32_impl, memory_order_relaxed)(array, key, size);
+}
+
+int64_t speedup_binary_search_f32(const float* array, float key, int64_t size) {
+    return atomic_load_explicit(&search_f32_impl, memory_order_relaxed)(array, key, size);
+}
@@ -0,0 +1,66 @@
+/* Generated by codegen/generate_specializations.py from codegen/types.yaml. Do not edit. */
+#include <stdatomic.h>
+#include "speedup/algorithms/binary_search_typed.h"
+#include "speedup/algorithms/binary_search.h"
+#include "speedup/backend/cpu_features.h"
+#include "core/speedup_internal.h"
+
+#if SPEEDUP_X86_64
+#include <immintrin.h>
+#endif
+
+typedef int64_t (*search_i64_fn)(const int64_t* array, int64_t key, int64_t size);
+
+#if SPEEDUP_X86_64
+/* 16 keys = 128 bytes = 4 vectors of 4 lanes. */
+#define WINDOW 16
+
+/* Branchless descent until at most WINDOW candidates remain, then count the
+ * keys < key in a WINDOW-wide block covering them. The block is moved left
+ * to stay inside the array; keys left of the descent base are all < key, so
+ * the count still lands on the lower bound. */
+SPEEDUP_TARGET_AVX2
+static int64_t search_i64_avx2(const int64_t* array, int64_t key, int64_t size) {
+    if (size < WINDOW) return speedup_binary_search_i64_branchless(array, key, size);
+
+    const int64_t* base = array;
+    int64_t len = size;
+    while (len > WINDOW) {
+        int64_t half = len / 2;
+        base = (base[half] < key) ? base + half : base;
+        len -= half;
+    }
+    const int64_t* start = (base + WINDOW <= array + size) ? base : array + size - WINDOW;
+
+    const __m256i x = _mm256_set1_epi64x(key);
+    int count = 0;
+    for (int i = 0; i < WINDOW; i += 4) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(start + i));
+        count += speedup_popcount32((uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi64(x, v)));
+    }
+
+    int64_t pos = (start - array) + (count >> 3);
+    return (pos < size && array[pos] == key) ? pos : -1;
+}
+
+#undef WINDOW
+#endif
+
+static int64_t search_i64_resolve(const int64_t* array, int64_t key, int64_t size);
+static _Atomic(search_i64_fn) search_i64_impl = search_i64_resolve;
+
+/* Picks the kernel on first call. Racing first callers pick the same one;
+ * the pointer is atomic so their stores never race with other readers. */
+static int64_t search_i64_resolve(const int64_t* array, int64_t key, int64_t size) {
+#if SPEEDUP_X86_64
+    search_i64_fn fn = speedup_cpu_has_avx2() ? search_i64_avx2 : speedup_binary_search_i64_branchless;
+#else
+    search_i64_fn fn = speedup_binary_search_i64_branchless;
+#endif
+    atomic_store_explicit(&search_i64_impl, fn, memory_order_relaxed);
+    return fn(array, key, size);
+}
+
+int64_t speedup_binary_search_i64_simd(const int64_t* array, int64_t key, int64_t size) {
+    return atomic_load_explicit(&search_i64_impl, memory_order_relaxed)(array, key, size);
+}
@@ -0,0 +1,11 @@
+# Generated by codegen/generate_specializations.py from codegen/types.yaml. Do not edit.
+set(SPEEDUP_GENERATED_SOURCES
+    ${CMAKE_CURRENT_LIST_DIR}/binary_search_i16.c
+    ${CMAKE_CURRENT_LIST_DIR}/binary_search_u16.c
+    ${CMAKE_CURRENT_LIST_DIR}/binary_search_i32.c
+    ${CMAKE_CURRENT_LIST_DIR}/binary_search_u32.c
+    ${CMAKE_CURRENT_LIST_DIR}/binary_search_i64.c
+    ${CMAKE_CURRENT_LIST_DIR}/binary_search_u64.c
+    ${CMAKE_CURRENT_LIST_DIR}/binary_search_f32.c
+    ${CMAKE_CURRENT_LIST_DIR}/binary_search_f64.c
+)
@@ -0,0 +1,210 @@
+#include "index_internal.h"
+#include "core/speedup_internal.h"
+#include <string.h>
+#include "speedup/backend/memory.h"
+#include "speedup/backend/numa.h"
+
+speedup_index_i64_t* speedup_index_i64_alloc(speedup_index_layout_t layout, int64_t size) {
+    speedup_index_i64_t* index = (speedup_index_i64_t*)calloc(1, sizeof(*index));
+    if (!index) return NULL;
+    index->layout = layout;
+    index->size = size;
+    return index;
+}
+
+void speedup_index_i64_sections(const speedup_index_i64_t* index, const void* data[SPEEDUP_INDEX_SECTIONS],
+                                uint64_t bytes[SPEEDUP_INDEX_SECTIONS]) {
+    data[0] = index->keys;
+    data[1] = index->ranks;
+    data[2] = index->segments;
+    bytes[0] = bytes[1] = bytes[2] = 0;
+    switch (index->layout) {
+    case SPEEDUP_INDEX_LAYOUT_EYTZINGER:
+        bytes[0] = bytes[1] = (uint64_t)(index->size + 1) * sizeof(int64_t);
+        break;
+    case SPEEDUP_INDEX_LAYOUT_STREE:
+        bytes[0] = (uint64_t)index->layer_offset[index->height] * sizeof(int64_t);
+        break;
+    case SPEEDUP_INDEX_LAYOUT_PGM:
+        bytes[0] = (uint64_t)index->size * sizeof(int64_t);
+        bytes[2] = (uint64_t)index->layer_offset[index->height] * sizeof(speedup_pgm_segment_t);
+        break;
+    case SPEEDUP_INDEX_LAYOUT_FOR:
+    case SPEEDUP_INDEX_LAYOUT_SUMMARY:
+        bytes[0] = (uint64_t)index->layer_offset[index->height] * sizeof(int64_t);
+        break;
+    }
+}
+
+/* Copy of index whose arrays live on node (-1: anywhere). */
+static speedup_index_i64_t* index_copy(const speedup_index_i64_t* index, int node) {
+    speedup_index_i64_t* copy = speedup_index_i64_alloc(index->layout, index->size);
+    if (!copy) return NULL;
+    memcpy(copy, index, sizeof(*copy));
+    copy->keys = NULL;
+    copy->ranks = NULL;
+    copy->segments = NULL;
+
+    const void* data[SPEEDUP_INDEX_SECTIONS];
+    uint64_t bytes[SPEEDUP_INDEX_SECTIONS];
+    void* out[SPEEDUP_INDEX_SECTIONS] = {NULL, NULL, NULL};
+    speedup_index_i64_sections(index, data, bytes);
+    int ok = 1;
+    for (int s = 0; s < SPEEDUP_INDEX_SECTIONS && ok; s++) {
+        if (!data[s]) continue;
+        out[s] = speedup_alloc_on_node((size_t)bytes[s], node);
+        ok = out[s] != NULL;
+        if (ok && bytes[s]) memcpy(out[s], data[s], (size_t)bytes[s]);
+    }
+    copy->keys = (int64_t*)out[0];
+    copy->ranks = (int64_t*)out[1];
+    copy->segments = (speedup_pgm_segment_t*)out[2];
+    if (!ok) {
+        speedup_index_i64_free(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+/* One copy per NUMA node, node 0's taking over the built arrays' role. Stays
+ * a single copy on one node or when a copy cannot be made. */
+static void index_replicate(speedup_index_i64_t* index) {
+    int nodes = speedup_numa_node_count();
+    if (nodes <= 1) return;
+    int bind = speedup_numa_nodes_are_physical();
+
+    speedup_index_i64_t** replicas = (speedup_index_i64_t**)calloc((size_t)nodes, sizeof(*replicas));
+    if (!replicas) return;
+    for (int node = 0; node < nodes; node++) {
+        replicas[node] = index_copy(index, bind ? node : -1);
+        if (!replicas[node]) {
+            for (int k = 0; k < node; k++) speedup_index_i64_free(replicas[k]);
+            free(replicas);
+            return;
+        }
+    }
+
+    speedup_free(index->keys);
+    speedup_free(index->ranks);
+    speedup_free(index->segments);
+    index->keys = replicas[0]->keys;
+    index->ranks = replicas[0]->ranks;
+    index->segments = replicas[0]->segments;
+    free(replicas[0]);
+    replicas[0] = index;
+    index->replicas = replicas;
+    index->replica_count = nodes;
+}
+
+/* param: pgm epsilon, or the summary cache budget in bytes (0: from the
+ * cache hint). */
+static speedup_index_i64_t* index_build(speedup_index_layout_t layout, const int64_t* sorted, int64_t size, int64_t param) {
+    if (size < 0 || (size > 0 && !sorted)) return NULL;
+
+    speedup_index_i64_t* index = speedup_index_i64_alloc(layout, size);
+    if (!index) return NULL;
+
+    int ok = 0;
+    switch (layout) {
+    case SPEEDUP_INDEX_LAYOUT_EYTZINGER:
+        ok = speedup_index_i64_init_eytzinger(index, sorted);
+        break;
+    case SPEEDUP_INDEX_LAYOUT_STREE:
+        ok = speedup_index_i64_init_stree(index, sorted);
+        break;
+    case SPEEDUP_INDEX_LAYOUT_PGM:
+        ok = speedup_index_i64_init_pgm(index, sorted, param);
+        break;
+    case SPEEDUP_INDEX_LAYOUT_FOR:
+        ok = speedup_index_i64_init_for(index, sorted);
+        break;
+    case SPEEDUP_INDEX_LAYOUT_SUMMARY:
+        ok = speedup_index_i64_init_summary(index, sorted, param);
+        break;
+    }
+
+    if (!ok) {
+        speedup_index_i64_free(index);
+        return NULL;
+    }
+    if (speedup_get_numa_replication()) index_replicate(index);
+    return index;
+}
+
+speedup_index_i64_t* speedup_index_i64_build(speedup_index_layout_t layout, const int64_t* sorted, int64_t size) {
+    return index_build(layout, sorted, size, layout == SPEEDUP_INDEX_LAYOUT_PGM ? SPEEDUP_PGM_DEFAULT_EPSILON : 0);
+}
+
+speedup_index_i64_t* speedup_index_i64_build_eytzinger(const int64_t* sorted, int64_t size) {
+    return speedup_index_i64_build(SPEEDUP_INDEX_LAYOUT_EYTZINGER, sorted, size);
+}
+
+speedup_index_i64_t* speedup_index_i64_build_stree(const int64_t* sorted, int64_t size) {
+    return speedup_index_i64_build(SPEEDUP_INDEX_LAYOUT_STREE, sorted, size);
+}
+
+speedup_index_i64_t* speedup_index_i64_build_pgm(const int64_t* sorted, int64_t size, int64_t epsilon) {
+    if (epsilon < 0) return NULL;
+    return index_build(SPEEDUP_INDEX_LAYOUT_PGM, sorted, size, epsilon ? epsilon : SPEEDUP_PGM_DEFAULT_EPSILON);
+}
+
+speedup_index_i64_t* speedup_index_i64_build_summary(const int64_t* sorted, int64_t size, int64_t cache_bytes) {
+    if (cache_bytes < 0) return NULL;
+    return index_build(SPEEDUP_INDEX_LAYOUT_SUMMARY, sorted, size, cache_bytes);
+}
+
+void speedup_index_i64_free(speedup_index_i64_t* index) {
+    if (!index) return;
+    if (index->replicas) {
+        for (int k = 1; k < index->replica_count; k++) speedup_index_i64_free(index->replicas[k]);
+        free(index->replicas);
+    }
+    if (index->mapping) {
+        speedup_index_i64_unmap(index);
+        free(index);
+        return;
+    }
+    speedup_free(index->keys);
+    speedup_free(index->ranks);
+    speedup_free(index->segments);
+    free(index);
+}
+
+int64_t speedup_index_i64_size(const speedup_index_i64_t* index) {
+    return index ? index->size : 0;
+}
+
+int64_t speedup_index_i64_memory_bytes(const speedup_index_i64_t* index) {
+    if (!index) return 0;
+    const void* data[SPEEDUP_INDEX_SECTIONS];
+    uint64_t bytes[SPEEDUP_INDEX_SECTIONS];
+    speedup_index_i64_sections(index, data, bytes);
+    int64_t copy = (int64_t)sizeof(*index);
+    for (int s = 0; s < SPEEDUP_INDEX_SECTIONS; s++) copy += (int64_t)bytes[s];
+    return copy * speedup_index_i64_replica_count(index);
+}
+
+int speedup_index_i64_replica_count(const speedup_index_i64_t* index) {
+    if (!index) return 0;
+    return index->replicas ? index->replica_count : 1;
+}
+
+int64_t speedup_index_i64_model_bytes(const speedup_index_i64_t* index) {
+    if (!index) return 0;
+    return speedup_index_i64_memory_bytes(index) - index->size * (int64_t)sizeof(int64_t);
+}
+
+speedup_index_layout_t speedup_index_i64_layout(const speedup_index_i64_t* index) {
+    return index->layout;
+}
+
+const char* speedup_index_layout_name(speedup_index_layout_t layout) {
+    switch (layout) {
+    case SPEEDUP_INDEX_LAYOUT_EYTZINGER: return "eytzinger";
+    case SPEEDUP_INDEX_LAYOUT_STREE: return "stree";
+    case SPEEDUP_INDEX_LAYOUT_PGM: return "pgm";
+    case SPEEDUP_INDEX_LAYOUT_FOR: return "for";
+    case SPEEDUP_INDEX_LAYOUT_SUMMARY: return "summary";
+    }
+    return NULL;
+}
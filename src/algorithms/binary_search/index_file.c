@@ -0,0 +1,287 @@
+#include <stdio.h>
+#include <string.h>
+#include "index_internal.h"
+#include "core/speedup_internal.h"
+#include "speedup/backend/cpu_features.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* File layout (version 1, writer's byte order):
+ *   [0, 4096)  index_file_header_t, zero padded
+ *   sections   keys, ranks, segments; each starts on a 4096-byte boundary so
+ *              the mapped arrays keep the alignment the kernels expect.
+ * Empty sections have offset 0 and 0 bytes. The header checksum covers every
+ * header byte before it; section checksums cover the section bytes. */
+
+#define INDEX_FILE_ALIGN 4096
+#define INDEX_FILE_BYTE_ORDER 0x01020304u
+#define INDEX_FILE_KEY_I64 1u
+
+static const char index_file_magic[8] = {'S', 'P', 'E', 'E', 'D', 'I', 'D', 'X'};
+
+typedef struct index_file_section_t {
+    uint64_t offset;
+    uint64_t bytes;
+    uint64_t checksum;
+} index_file_section_t;
+
+typedef struct index_file_header_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t layout;
+    uint32_t key_type;
+    int32_t height;
+    uint32_t reserved;
+    int64_t size;
+    int64_t epsilon;
+    int64_t layer_offset[SPEEDUP_INDEX_MAX_LAYERS + 1];
+    index_file_section_t sections[SPEEDUP_INDEX_SECTIONS];
+    uint64_t file_bytes;
+    uint64_t header_checksum;
+} index_file_header_t;
+
+typedef char index_file_header_fits[sizeof(index_file_header_t) <= INDEX_FILE_ALIGN ? 1 : -1];
+
+/* xxHash64-style rounds over four independent lanes, so checksumming keeps
+ * up with sequential reads. Every section is a whole number of 8-byte words. */
+#define CHECKSUM_P1 0x9E3779B185EBCA87ull
+#define CHECKSUM_P2 0xC2B2AE3D27D4EB4Full
+
+static inline uint64_t checksum_round(uint64_t acc, uint64_t word) {
+    acc += word * CHECKSUM_P2;
+    acc = (acc << 31) | (acc >> 33);
+    return acc * CHECKSUM_P1;
+}
+
+static uint64_t index_file_checksum(const void* data, uint64_t bytes) {
+    const uint64_t* w = (const uint64_t*)data;
+    uint64_t n = bytes / 8;
+    uint64_t lane[4] = {CHECKSUM_P1, CHECKSUM_P2, 0, (uint64_t)0 - CHECKSUM_P1};
+    uint64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        lane[0] = checksum_round(lane[0], w[i]);
+        lane[1] = checksum_round(lane[1], w[i + 1]);
+        lane[2] = checksum_round(lane[2], w[i + 2]);
+        lane[3] = checksum_round(lane[3], w[i + 3]);
+    }
+    uint64_t h = bytes;
+    for (int k = 0; k < 4; k++) h = checksum_round(h ^ lane[k], (uint64_t)k);
+    for (; i < n; i++) h = checksum_round(h, w[i]);
+    h ^= h >> 29;
+    h *= CHECKSUM_P2;
+    return h ^ (h >> 32);
+}
+
+static uint64_t header_checksum(const index_file_header_t* h) {
+    return index_file_checksum(h, offsetof(index_file_header_t, header_checksum));
+}
+
+static uint64_t align_up(uint64_t n) {
+    return (n + INDEX_FILE_ALIGN - 1) / INDEX_FILE_ALIGN * INDEX_FILE_ALIGN;
+}
+
+static int write_padding(FILE* f, uint64_t bytes) {
+    static const char zeros[INDEX_FILE_ALIGN];
+    return bytes == 0 || fwrite(zeros, 1, (size_t)bytes, f) == bytes;
+}
+
+int speedup_index_i64_save(const speedup_index_i64_t* index, const char* path) {
+    if (!index || !path) return -1;
+
+    index_file_header_t h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, index_file_magic, sizeof(h.magic));
+    h.version = SPEEDUP_INDEX_FILE_VERSION;
+    h.byte_order = INDEX_FILE_BYTE_ORDER;
+    h.layout = (uint32_t)index->layout;
+    h.key_type = INDEX_FILE_KEY_I64;
+    h.height = index->height;
+    h.size = index->size;
+    h.epsilon = index->epsilon;
+    memcpy(h.layer_offset, index->layer_offset, sizeof(h.layer_offset));
+
+    const void* data[SPEEDUP_INDEX_SECTIONS];
+    uint64_t bytes[SPEEDUP_INDEX_SECTIONS];
+    speedup_index_i64_sections(index, data, bytes);
+    uint64_t end = INDEX_FILE_ALIGN;
+    for (int s = 0; s < SPEEDUP_INDEX_SECTIONS; s++) {
+        if (bytes[s] == 0) continue;
+        h.sections[s].offset = end;
+        h.sections[s].bytes = bytes[s];
+        h.sections[s].checksum = index_file_checksum(data[s], bytes[s]);
+        end = align_up(end + bytes[s]);
+    }
+    h.file_bytes = end;
+    h.header_checksum = header_checksum(&h);
+
+    char* tmp = NULL;
+    FILE* f = speedup_file_create_temp(path, &tmp);
+    int ok = f != NULL;
+    if (ok) {
+        ok = fwrite(&h, sizeof(h), 1, f) == 1 && write_padding(f, INDEX_FILE_ALIGN - sizeof(h));
+        uint64_t pos = INDEX_FILE_ALIGN;
+        for (int s = 0; ok && s < SPEEDUP_INDEX_SECTIONS; s++) {
+            if (bytes[s] == 0) continue;
+            ok = fwrite(data[s], 1, (size_t)bytes[s], f) == bytes[s];
+            pos += bytes[s];
+            ok = ok && write_padding(f, align_up(pos) - pos);
+            pos = align_up(pos);
+        }
+        ok = speedup_file_commit_temp(f, tmp, path, ok) == 0;
+    }
+    return ok ? 0 : -1;
+}
+
+/* Maps the whole file read-only and shared; returns NULL on failure. */
+static void* map_file(const char* path, int64_t* bytes) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+    LARGE_INTEGER size;
+    void* p = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart >= INDEX_FILE_ALIGN) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            p = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+    *bytes = p ? (int64_t)size.QuadPart : 0;
+    return p;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    void* p = NULL;
+    if (fstat(fd, &st) == 0 && st.st_size >= INDEX_FILE_ALIGN) {
+        p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) p = NULL;
+    }
+    close(fd);
+    *bytes = p ? (int64_t)st.st_size : 0;
+    return p;
+#endif
+}
+
+void speedup_index_i64_unmap(speedup_index_i64_t* index) {
+#if defined(_WIN32)
+    UnmapViewOfFile(index->mapping);
+#else
+    munmap(index->mapping, (size_t)index->mapping_bytes);
+#endif
+    index->mapping = NULL;
+}
+
+/* Everything a lookup relies on, checked against the header alone. */
+static int header_valid(const index_file_header_t* h, uint64_t file_bytes) {
+    if (memcmp(h->magic, index_file_magic, sizeof(h->magic)) != 0) return 0;
+    if (h->version != SPEEDUP_INDEX_FILE_VERSION || h->byte_order != INDEX_FILE_BYTE_ORDER) return 0;
+    if (h->key_type != INDEX_FILE_KEY_I64 || !speedup_index_layout_name((speedup_index_layout_t)h->layout)) return 0;
+    if (h->header_checksum != header_checksum(h) || h->file_bytes != file_bytes) return 0;
+    if (h->size < 0 || h->epsilon < 0 || h->height < 0 || h->height > SPEEDUP_INDEX_MAX_LAYERS) return 0;
+    /* Bounds keep the section size computations below from overflowing. */
+    if (h->size > INT64_MAX / 32 || h->layer_offset[0] != 0) return 0;
+    for (int i = 0; i < h->height; i++) {
+        if (h->layer_offset[i + 1] < h->layer_offset[i] || (uint64_t)h->layer_offset[i + 1] > file_bytes) return 0;
+    }
+    switch ((speedup_index_layout_t)h->layout) {
+    case SPEEDUP_INDEX_LAYOUT_EYTZINGER: return 1;
+    case SPEEDUP_INDEX_LAYOUT_STREE:
+        return h->height >= 1 && h->height <= SPEEDUP_STREE_MAX_HEIGHT && h->layer_offset[1] >= h->size;
+    case SPEEDUP_INDEX_LAYOUT_PGM:
+        if (h->height < 1) return 0;
+        for (int i = 0; i < h->height && h->size > 0; i++) {
+            if (h->layer_offset[i + 1] == h->layer_offset[i]) return 0;
+        }
+        return 1;
+    case SPEEDUP_INDEX_LAYOUT_FOR:
+        return h->height == 1 && h->layer_offset[1] >= 2 * ((h->size + SPEEDUP_FOR_BLOCK - 1) / SPEEDUP_FOR_BLOCK);
+    case SPEEDUP_INDEX_LAYOUT_SUMMARY:
+        return h->height == 2 && h->epsilon >= 1 && h->layer_offset[1] >= (h->size + h->epsilon - 1) / h->epsilon &&
+               h->layer_offset[2] == h->layer_offset[1] + h->size;
+    }
+    return 0;
+}
+
+speedup_index_i64_t* speedup_index_i64_open(const char* path, speedup_index_open_flags_t flags) {
+    if (!path) return NULL;
+    int64_t file_bytes = 0;
+    char* base = (char*)map_file(path, &file_bytes);
+    if (!base) return NULL;
+
+    const index_file_header_t* h = (const index_file_header_t*)base;
+    speedup_index_i64_t* index = NULL;
+    if (header_valid(h, (uint64_t)file_bytes)) {
+        index = speedup_index_i64_alloc((speedup_index_layout_t)h->layout, h->size);
+    }
+    if (!index) {
+        speedup_index_i64_t closing;
+        closing.mapping = base;
+        closing.mapping_bytes = file_bytes;
+        speedup_index_i64_unmap(&closing);
+        return NULL;
+    }
+
+    index->mapping = base;
+    index->mapping_bytes = file_bytes;
+    index->height = h->height;
+    index->epsilon = h->epsilon;
+    memcpy(index->layer_offset, h->layer_offset, sizeof(index->layer_offset));
+    index->use_avx2 = SPEEDUP_X86_64 && speedup_cpu_has_avx2();
+
+    /* Sections must have exactly the sizes the layout implies and lie inside
+     * the file, aligned, so lookups never read past the mapping. */
+    const void* unused[SPEEDUP_INDEX_SECTIONS];
+    uint64_t bytes[SPEEDUP_INDEX_SECTIONS];
+    speedup_index_i64_sections(index, unused, bytes);
+    int ok = 1;
+    void* data[SPEEDUP_INDEX_SECTIONS] = {NULL, NULL, NULL};
+    for (int s = 0; s < SPEEDUP_INDEX_SECTIONS; s++) {
+        const index_file_section_t* sec = &h->sections[s];
+        index->checksums[s] = sec->checksum;
+        if (sec->bytes != bytes[s]) ok = 0;
+        if (sec->bytes == 0) continue;
+        if (sec->offset % INDEX_FILE_ALIGN || sec->offset < INDEX_FILE_ALIGN || sec->offset > (uint64_t)file_bytes ||
+            sec->bytes > (uint64_t)file_bytes - sec->offset) {
+            ok = 0;
+            continue;
+        }
+        data[s] = base + sec->offset;
+    }
+    index->keys = (int64_t*)data[0];
+    index->ranks = (int64_t*)data[1];
+    index->segments = (speedup_pgm_segment_t*)data[2];
+
+    if (ok && (flags & SPEEDUP_INDEX_OPEN_VERIFY)) ok = speedup_index_i64_verify(index) == 0;
+    if (!ok) {
+        speedup_index_i64_free(index);
+        return NULL;
+    }
+#if !defined(_WIN32) && defined(MADV_RANDOM)
+    /* Lookups touch scattered pages; readahead would only evict others. */
+    madvise(base, (size_t)file_bytes, MADV_RANDOM);
+#endif
+    return index;
+}
+
+int speedup_index_i64_verify(const speedup_index_i64_t* index) {
+    if (!index) return -1;
+    if (!index->mapping) return 0;
+    const void* data[SPEEDUP_INDEX_SECTIONS];
+    uint64_t bytes[SPEEDUP_INDEX_SECTIONS];
+    speedup_index_i64_sections(index, data, bytes);
+    for (int s = 0; s < SPEEDUP_INDEX_SECTIONS; s++) {
+        if (bytes[s] && index_file_checksum(data[s], bytes[s]) != index->checksums[s]) return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <stdatomic.h>
+#include <string.h>
+#include "speedup/algorithms/index_handle.h"
+#include "speedup/backend/memory.h"
+#include "core/speedup_internal.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+#define SPEEDUP_HANDLE_SHARDS 64
+
+/* Readers in section, by the parity of the phase they entered under. Each
+ * shard has its own cache line. */
+typedef struct handle_shard_t {
+    _Alignas(SPEEDUP_CACHELINE) _Atomic int64_t readers[2];
+} handle_shard_t;
+
+/* Grace periods follow sleepable RCU: publish advances phase, so new readers
+ * count on the other parity, and waits for the old parity to drain. Two
+ * rounds also cover a reader that read the phase just before a flip but
+ * incremented after the previous publish finished waiting. */
+struct speedup_index_handle_t {
+    _Alignas(SPEEDUP_CACHELINE) _Atomic(speedup_index_i64_t*) current;
+    _Atomic uint32_t phase;
+    _Atomic uint64_t version;
+    atomic_flag publishing;
+    handle_shard_t shards[SPEEDUP_HANDLE_SHARDS];
+};
+
+static _Atomic uint32_t g_next_shard = 0;
+static SPEEDUP_THREAD_LOCAL uint32_t t_shard = 0;  /* shard + 1, 0 unassigned */
+
+static inline uint32_t thread_shard(void) {
+    if (t_shard == 0) {
+        t_shard = atomic_fetch_add_explicit(&g_next_shard, 1, memory_order_relaxed) % SPEEDUP_HANDLE_SHARDS + 1;
+    }
+    return t_shard - 1;
+}
+
+static void yield_thread(void) {
+#if defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+speedup_index_handle_t* speedup_index_handle_create(speedup_index_i64_t* index) {
+    speedup_index_handle_t* handle = (speedup_index_handle_t*)speedup_alloc(sizeof(*handle));
+    if (!handle) return NULL;
+    memset(handle, 0, sizeof(*handle));
+    atomic_init(&handle->current, index);
+    atomic_init(&handle->phase, 0);
+    atomic_init(&handle->version, 1);
+    atomic_flag_clear(&handle->publishing);
+    for (int s = 0; s < SPEEDUP_HANDLE_SHARDS; s++) {
+        atomic_init(&handle->shards[s].readers[0], 0);
+        atomic_init(&handle->shards[s].readers[1], 0);
+    }
+    return handle;
+}
+
+void speedup_index_handle_free(speedup_index_handle_t* handle) {
+    if (!handle) return;
+    speedup_index_i64_free(atomic_load(&handle->current));
+    speedup_free(handle);
+}
+
+/* The increment is ordered before the pointer load (both sequentially
+ * consistent): a publisher that sees the counter at zero has swapped the
+ * pointer first, so a reader it missed loads the new version. */
+const speedup_index_i64_t* speedup_index_handle_acquire(speedup_index_handle_t* handle, speedup_index_guard_t* guard) {
+    uint32_t shard = thread_shard();
+    uint32_t parity = atomic_load(&handle->phase) & 1;
+    atomic_fetch_add(&handle->shards[shard].readers[parity], 1);
+    guard->shard = shard;
+    guard->phase = parity;
+    return atomic_load(&handle->current);
+}
+
+void speedup_index_handle_release(speedup_index_handle_t* handle, const speedup_index_guard_t* guard) {
+    atomic_fetch_sub_explicit(&handle->shards[guard->shard].readers[guard->phase], 1, memory_order_release);
+}
+
+int64_t speedup_index_handle_find(speedup_index_handle_t* handle, int64_t key) {
+    speedup_index_guard_t guard;
+    const speedup_index_i64_t* index = speedup_index_handle_acquire(handle, &guard);
+    int64_t pos = index ? speedup_index_i64_find(index, key) : -1;
+    speedup_index_handle_release(handle, &guard);
+    return pos;
+}
+
+static void wait_for_readers(speedup_index_handle_t* handle, uint32_t parity) {
+    for (;;) {
+        int64_t active = 0;
+        for (int s = 0; s < SPEEDUP_HANDLE_SHARDS; s++) {
+            active += atomic_load(&handle->shards[s].readers[parity]);
+        }
+        if (active == 0) return;
+        yield_thread();
+    }
+}
+
+void speedup_index_handle_publish(speedup_index_handle_t* handle, speedup_index_i64_t* index) {
+    while (atomic_flag_test_and_set_explicit(&handle->publishing, memory_order_acquire)) yield_thread();
+
+    speedup_index_i64_t* old = atomic_exchange(&handle->current, index);
+    atomic_fetch_add(&handle->version, 1);
+    for (int round = 0; round < 2; round++) {
+        uint32_t phase = atomic_load(&handle->phase);
+        atomic_store(&handle->phase, phase + 1);
+        wait_for_readers(handle, phase & 1);
+    }
+
+    atomic_flag_clear_explicit(&handle->publishing, memory_order_release);
+    speedup_index_i64_free(old);
+}
+
+uint64_t speedup_index_handle_version(const speedup_index_handle_t* handle) {
+    return atomic_load(&((speedup_index_handle_t*)handle)->version);
+}
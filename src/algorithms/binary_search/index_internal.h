@@ -0,0 +1,76 @@
+#pragma once
+#include "speedup/algorithms/index.h"
+#include "speedup/algorithms/search_inline.h"
+
+/* Node size of the S-tree kernels in search_inline.h. */
+#define SPEEDUP_STREE_B SPEEDUP_INLINE_BLOCK_KEYS
+#define SPEEDUP_STREE_MAX_HEIGHT 24
+
+/* Upper bound on stacked layers of any layout (PGM levels at least halve). */
+#define SPEEDUP_INDEX_MAX_LAYERS 64
+
+#define SPEEDUP_PGM_DEFAULT_EPSILON 64
+
+#define SPEEDUP_FOR_BLOCK 128
+
+/* Arrays an index owns, in the order index files store them. */
+#define SPEEDUP_INDEX_SECTIONS 3
+
+/* pgm: keys in [key, next segment's key) are predicted at
+ * intercept + slope * (key - this key). */
+typedef struct speedup_pgm_segment_t {
+    int64_t key;
+    int64_t intercept;
+    double slope;
+} speedup_pgm_segment_t;
+
+struct speedup_index_i64_t {
+    speedup_index_layout_t layout;
+    int64_t size;
+    int64_t* keys;   /* layout-ordered keys, cache-line aligned */
+    int64_t* ranks;  /* eytzinger: sorted position of keys[k] */
+
+    /* stree: layer h starts at keys + layer_offset[h]; layer 0 is the leaves.
+     * for: keys is the packed block array of layer_offset[1] words.
+     * pgm: level h is segments[layer_offset[h] .. layer_offset[h + 1]). */
+    int height;
+    int use_avx2;
+    int64_t layer_offset[SPEEDUP_INDEX_MAX_LAYERS + 1];
+
+    /* pgm: keys is the sorted array, each leaf prediction is within epsilon.
+     * summary: keys is layer 0 (every epsilon-th key) then layer 1 (all keys). */
+    speedup_pgm_segment_t* segments;
+    int64_t epsilon;
+
+    /* opened from a file: keys, ranks and segments point into this mapping */
+    void* mapping;
+    int64_t mapping_bytes;
+    uint64_t checksums[SPEEDUP_INDEX_SECTIONS];
+
+    /* NUMA replication: one copy per node, replicas[0] is this index */
+    struct speedup_index_i64_t** replicas;
+    int replica_count;
+};
+
+speedup_index_i64_t* speedup_index_i64_alloc(speedup_index_layout_t layout, int64_t size);
+void speedup_index_i64_unmap(speedup_index_i64_t* index);
+
+/* keys, ranks and segments with their exact sizes, derived from size and the
+ * layer offsets alone (so a file header can be checked before trusting it). */
+void speedup_index_i64_sections(const speedup_index_i64_t* index, const void* data[SPEEDUP_INDEX_SECTIONS],
+                                uint64_t bytes[SPEEDUP_INDEX_SECTIONS]);
+
+int speedup_index_i64_init_eytzinger(speedup_index_i64_t* index, const int64_t* sorted);
+int64_t speedup_index_i64_find_eytzinger(const speedup_index_i64_t* index, int64_t key);
+
+int speedup_index_i64_init_stree(speedup_index_i64_t* index, const int64_t* sorted);
+int64_t speedup_index_i64_find_stree(const speedup_index_i64_t* index, int64_t key);
+
+int speedup_index_i64_init_pgm(speedup_index_i64_t* index, const int64_t* sorted, int64_t epsilon);
+int64_t speedup_index_i64_find_pgm(const speedup_index_i64_t* index, int64_t key);
+
+int speedup_index_i64_init_for(speedup_index_i64_t* index, const int64_t* sorted);
+int64_t speedup_index_i64_find_for(const speedup_index_i64_t* index, int64_t key);
+
+int speedup_index_i64_init_summary(speedup_index_i64_t* index, const int64_t* sorted, int64_t cache_bytes);
+int64_t speedup_index_i64_find_summary(const speedup_index_i64_t* index, int64_t key);
@@ -0,0 +1,104 @@
+#include <stdatomic.h>
+#include <string.h>
+#include "speedup/algorithms/binary_search.h"
+#include "speedup/backend/cpu_features.h"
+#include "speedup/backend/kernels.h"
+#include "speedup/config.h"
+#include "kernel_table.h"
+
+#if SPEEDUP_ENABLE_ASM
+#include "backends/cpu/x86_64/binary_search_asm.h"
+#endif
+
+typedef struct speedup_kernel_entry_t {
+    speedup_kernel_info_t info;
+    int (*available)(void);
+    int profile_only;  /* selected by name in a profile, never by calibration */
+} speedup_kernel_entry_t;
+
+static const speedup_kernel_entry_t g_entries[] = {
+    {.info = {"ref", speedup_binary_search_i64_ref}},
+    {.info = {"branchless", speedup_binary_search_i64_branchless}},
+    {.info = {"branchless_prefetch", speedup_binary_search_i64_branchless_prefetch}},
+    {.info = {"avx2", speedup_binary_search_i64_avx2}, .available = speedup_cpu_has_avx2},
+    /* Fast on near-uniform keys, up to twice a binary search on skewed ones;
+     * calibration arrays are uniform, so it would always win there. */
+    {.info = {"interpolation", speedup_binary_search_i64_interpolation}, .profile_only = 1},
+#if SPEEDUP_ENABLE_ASM
+    {.info = {"asm_branching", SPEEDUP_ASM_KERNEL(branching)}},
+    {.info = {"asm_branchless", SPEEDUP_ASM_KERNEL(branchless)}},
+    {.info = {"asm_optimized", SPEEDUP_ASM_KERNEL(optimized)}},
+#endif
+};
+
+/* Untuned CPU kernel: the AVX2 kernel where the CPU has it (it beats both ASM
+ * kernels at 1K-10M keys, though branchless_prefetch measured faster at 100K;
+ * a tuning profile can pick that per band); otherwise the software-pipelined
+ * ASM kernel, the most stable across sizes in the baseline, or the C
+ * reference. */
+#define SPEEDUP_PREFERRED_KERNEL "avx2"
+#if SPEEDUP_ENABLE_ASM
+#define SPEEDUP_DEFAULT_KERNEL "asm_optimized"
+#else
+#define SPEEDUP_DEFAULT_KERNEL "ref"
+#endif
+
+#define SPEEDUP_KERNEL_ENTRIES ((int)(sizeof(g_entries) / sizeof(g_entries[0])))
+
+/* g_available_count: -1 before the list is built, -2 while one caller builds
+ * it, then the count. Only that caller writes the list, so readers never see
+ * it being written. */
+static const speedup_kernel_info_t* g_available[SPEEDUP_KERNEL_ENTRIES];
+static _Atomic int g_available_count = -1;
+
+static int registry_init(void) {
+    int count = atomic_load_explicit(&g_available_count, memory_order_acquire);
+    if (count >= 0) return count;
+
+    int expected = -1;
+    if (atomic_compare_exchange_strong_explicit(&g_available_count, &expected, -2, memory_order_acquire,
+                                                memory_order_acquire)) {
+        count = 0;
+        for (int i = 0; i < SPEEDUP_KERNEL_ENTRIES; i++) {
+            if (!g_entries[i].available || g_entries[i].available()) {
+                g_available[count++] = &g_entries[i].info;
+            }
+        }
+        atomic_store_explicit(&g_available_count, count, memory_order_release);
+        return count;
+    }
+    /* Another caller is building it: a few feature checks away. */
+    while ((count = atomic_load_explicit(&g_available_count, memory_order_acquire)) < 0) {
+    }
+    return count;
+}
+
+int speedup_kernel_count(void) {
+    return registry_init();
+}
+
+const speedup_kernel_info_t* speedup_kernel_get(int i) {
+    if (i < 0 || i >= registry_init()) return NULL;
+    return g_available[i];
+}
+
+const speedup_kernel_info_t* speedup_kernel_find(const char* name) {
+    int count = registry_init();
+    for (int i = 0; i < count; i++) {
+        if (strcmp(g_available[i]->name, name) == 0) return g_available[i];
+    }
+    return NULL;
+}
+
+const speedup_kernel_info_t* speedup_kernel_default(void) {
+    const speedup_kernel_info_t* kernel = speedup_kernel_find(SPEEDUP_PREFERRED_KERNEL);
+    if (!kernel) kernel = speedup_kernel_find(SPEEDUP_DEFAULT_KERNEL);
+    return kernel ? kernel : &g_entries[0].info;
+}
+
+int speedup_kernel_calibrated(const speedup_kernel_info_t* kernel) {
+    for (int i = 0; i < SPEEDUP_KERNEL_ENTRIES; i++) {
+        if (&g_entries[i].info == kernel) return !g_entries[i].profile_only;
+    }
+    return 0;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "speedup/backend/kernels.h"
+
+typedef void (*speedup_batch_i64_fn)(const int64_t* array, int64_t size, const int64_t* keys, int64_t n, int64_t* out);
+typedef int64_t (*speedup_strided_i64_fn)(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size);
+
+/* Kernels behind the public entry points, resolved once from the backend
+ * preference and CPU features by speedup_kernels_resolve() (called from
+ * speedup_init and speedup_set_backend_preference). Until then each entry
+ * resolves the table on first use. Resolution can rerun while other threads
+ * search, so every entry is an atomic pointer, stored with release and loaded
+ * with acquire through SPEEDUP_KERNEL; each one is a complete kernel on its
+ * own, so a reader that sees old and new entries mixed still searches
+ * correctly. */
+typedef struct speedup_kernel_table_t {
+    _Atomic(speedup_search_i64_fn) search_i64;
+    _Atomic(speedup_batch_i64_fn) batch_i64;
+    _Atomic(speedup_batch_i64_fn) batch_sorted_i64;
+    _Atomic(speedup_search_i64_fn) lower_bound_i64;
+    _Atomic(speedup_search_i64_fn) upper_bound_i64;
+    _Atomic(speedup_batch_i64_fn) batch_lower_bound_i64;
+    _Atomic(speedup_batch_i64_fn) batch_upper_bound_i64;
+    _Atomic(speedup_strided_i64_fn) search_strided_i64;
+} speedup_kernel_table_t;
+
+extern speedup_kernel_table_t speedup_kernels;
+
+#define SPEEDUP_KERNEL(entry) atomic_load_explicit(&speedup_kernels.entry, memory_order_acquire)
+
+void speedup_kernels_resolve(void);
+
+/* Size-banded CPU kernel from the tuning profile, or NULL when untuned. */
+speedup_search_i64_fn speedup_tuning_search_i64(void);
+
+/* 0 for kernels calibration must not time: their speed depends on the key
+ * distribution, which the calibration arrays cannot stand in for. Profiles
+ * can still name them. */
+int speedup_kernel_calibrated(const speedup_kernel_info_t* kernel);
+
+/* CPU kernel used when no tuning profile is active. */
+const speedup_kernel_info_t* speedup_kernel_default(void);
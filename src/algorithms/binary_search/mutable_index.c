@@ -0,0 +1,262 @@
+#include <string.h>
+#include "speedup/algorithms/mutable_index.h"
+#include "speedup/algorithms/binary_search.h"
+#include "speedup/backend/dispatch.h"
+#include "speedup/backend/memory.h"
+#include "core/speedup_internal.h"
+
+/* Four buffers (active and frozen inserts and tombstones) share the L2 hint. */
+#define SPEEDUP_MUTABLE_MIN_CAPACITY 256
+#define SPEEDUP_MUTABLE_DEFAULT_L2 262144
+
+/* The set is (main - frozen_tomb + frozen_delta) - tomb + delta:
+ *   main          sorted keys
+ *   frozen_*      buffers being merged into next (empty when not merging);
+ *                 frozen_tomb is a subset of main, frozen_delta is disjoint
+ *                 from it
+ *   delta, tomb   buffers taking new changes; tomb is a subset of the frozen
+ *                 view, delta is disjoint from it
+ * Each buffer is sorted. */
+struct speedup_mutable_i64_t {
+    int64_t* main;
+    int64_t main_size;
+    int64_t main_capacity;
+    int64_t* delta;
+    int64_t delta_size;
+    int64_t* tomb;
+    int64_t tomb_size;
+    int64_t* frozen_delta;
+    int64_t frozen_delta_size;
+    int64_t* frozen_tomb;
+    int64_t frozen_tomb_size;
+    int64_t* buffers;
+    int64_t capacity;
+    int64_t count;
+
+    /* Merge in progress when next is set: cursors into main, frozen_delta and
+     * frozen_tomb, and the elements to move per change. spare is the main
+     * array before the last merge, kept for the next one: reusing it avoids
+     * the page faults of a fresh allocation and the unmap of the old one,
+     * which would otherwise land on single calls as latency spikes. */
+    int64_t* next;
+    int64_t next_size;
+    int64_t next_capacity;
+    int64_t main_pos;
+    int64_t delta_pos;
+    int64_t tomb_pos;
+    int64_t step;
+    int64_t* spare;
+    int64_t spare_capacity;
+};
+
+static inline int buffer_has(const int64_t* buffer, int64_t size, int64_t key) {
+    if (size == 0) return 0;
+    int64_t pos = speedup_lower_bound_i64_branchless(buffer, key, size);
+    return pos < size && buffer[pos] == key;
+}
+
+static void buffer_add(int64_t* buffer, int64_t* size, int64_t key) {
+    int64_t pos = speedup_lower_bound_i64_branchless(buffer, key, *size);
+    memmove(buffer + pos + 1, buffer + pos, (size_t)(*size - pos) * sizeof(int64_t));
+    buffer[pos] = key;
+    (*size)++;
+}
+
+/* Removes key if present; returns whether it was. */
+static int buffer_remove(int64_t* buffer, int64_t* size, int64_t key) {
+    int64_t pos = speedup_lower_bound_i64_branchless(buffer, key, *size);
+    if (pos == *size || buffer[pos] != key) return 0;
+    memmove(buffer + pos, buffer + pos + 1, (size_t)(*size - pos - 1) * sizeof(int64_t));
+    (*size)--;
+    return 1;
+}
+
+/* Membership in main - frozen_tomb + frozen_delta. */
+static inline int frozen_has(const speedup_mutable_i64_t* set, int64_t key) {
+    if (set->main_size > 0 && speedup_binary_search_i64(set->main, key, set->main_size) >= 0) {
+        return !buffer_has(set->frozen_tomb, set->frozen_tomb_size, key);
+    }
+    return buffer_has(set->frozen_delta, set->frozen_delta_size, key);
+}
+
+/* Moves up to budget elements into next (all of them for budget < 0) and
+ * installs next as main once the frozen buffers are used up. */
+static void merge_advance(speedup_mutable_i64_t* set, int64_t budget) {
+    const int64_t* main = set->main;
+    const int64_t* delta = set->frozen_delta;
+    const int64_t* tomb = set->frozen_tomb;
+    int64_t i = set->main_pos;
+    int64_t j = set->delta_pos;
+    int64_t t = set->tomb_pos;
+    int64_t n = set->next_size;
+    int64_t main_size = set->main_size;
+    int64_t delta_size = set->frozen_delta_size;
+    int64_t tomb_size = set->frozen_tomb_size;
+
+    for (; budget != 0 && (i < main_size || j < delta_size); budget--) {
+        if (j < delta_size && (i == main_size || delta[j] < main[i])) {
+            set->next[n++] = delta[j++];
+        } else if (t < tomb_size && tomb[t] == main[i]) {
+            i++;
+            t++;
+        } else {
+            set->next[n++] = main[i++];
+        }
+    }
+    set->main_pos = i;
+    set->delta_pos = j;
+    set->tomb_pos = t;
+    set->next_size = n;
+    if (i < main_size || j < delta_size) return;
+
+    set->spare = set->main;
+    set->spare_capacity = set->main_capacity;
+    set->main = set->next;
+    set->main_size = n;
+    set->main_capacity = set->next_capacity;
+    set->next = NULL;
+    set->frozen_delta_size = 0;
+    set->frozen_tomb_size = 0;
+}
+
+/* Pre-faulted array for at least need keys, with room to grow by an eighth
+ * before the next reallocation. */
+static int64_t* alloc_main(int64_t need, int64_t* capacity) {
+    int64_t n = need + need / 8 + SPEEDUP_MUTABLE_MIN_CAPACITY;
+    int64_t* array = (int64_t*)speedup_alloc((size_t)n * sizeof(int64_t));
+    if (!array) return NULL;
+    memset(array, 0, (size_t)n * sizeof(int64_t));
+    *capacity = n;
+    return array;
+}
+
+/* Freezes the active buffers and starts merging them into the spare array. */
+static int merge_start(speedup_mutable_i64_t* set) {
+    int64_t total = set->main_size + set->delta_size;
+    if (set->spare_capacity < total) {
+        speedup_free(set->spare);
+        set->spare = alloc_main(total, &set->spare_capacity);
+        if (!set->spare) {
+            set->spare_capacity = 0;
+            return -1;
+        }
+    }
+
+    int64_t* swap = set->frozen_delta;
+    set->frozen_delta = set->delta;
+    set->frozen_delta_size = set->delta_size;
+    set->delta = swap;
+    set->delta_size = 0;
+    swap = set->frozen_tomb;
+    set->frozen_tomb = set->tomb;
+    set->frozen_tomb_size = set->tomb_size;
+    set->tomb = swap;
+    set->tomb_size = 0;
+
+    set->next = set->spare;
+    set->next_size = 0;
+    set->next_capacity = set->spare_capacity;
+    set->spare = NULL;
+    set->spare_capacity = 0;
+    set->main_pos = 0;
+    set->delta_pos = 0;
+    set->tomb_pos = 0;
+    /* Done within capacity / 2 changes, before the new buffers can fill. */
+    int64_t changes = set->capacity / 2;
+    set->step = (total + changes - 1) / changes + 1;
+    return 0;
+}
+
+/* Makes room for one more change in the active buffers. */
+static int ensure_room(speedup_mutable_i64_t* set) {
+    if (set->delta_size < set->capacity && set->tomb_size < set->capacity) return 0;
+    if (set->next) merge_advance(set, -1);
+    return merge_start(set);
+}
+
+speedup_mutable_i64_t* speedup_mutable_i64_create(const int64_t* sorted, int64_t size) {
+    if (size < 0 || (size > 0 && !sorted) || !speedup_keys_sorted_i64(sorted, size)) return NULL;
+
+    speedup_mutable_i64_t* set = (speedup_mutable_i64_t*)calloc(1, sizeof(*set));
+    if (!set) return NULL;
+
+    int64_t capacity = (int64_t)speedup_get_cache_hint().l2_bytes;
+    if (capacity <= 0) capacity = SPEEDUP_MUTABLE_DEFAULT_L2;
+    capacity /= 4 * (int64_t)sizeof(int64_t);
+    if (capacity < SPEEDUP_MUTABLE_MIN_CAPACITY) capacity = SPEEDUP_MUTABLE_MIN_CAPACITY;
+    set->capacity = capacity;
+
+    set->buffers = (int64_t*)speedup_alloc((size_t)(4 * capacity) * sizeof(int64_t));
+    set->main = alloc_main(size, &set->main_capacity);
+    set->spare = alloc_main(size, &set->spare_capacity);
+    if (!set->buffers || !set->main || !set->spare) {
+        speedup_mutable_i64_free(set);
+        return NULL;
+    }
+    set->delta = set->buffers;
+    set->tomb = set->buffers + capacity;
+    set->frozen_delta = set->buffers + 2 * capacity;
+    set->frozen_tomb = set->buffers + 3 * capacity;
+
+    int64_t n = 0;
+    for (int64_t i = 0; i < size; i++) {
+        if (n == 0 || sorted[i] != set->main[n - 1]) set->main[n++] = sorted[i];
+    }
+    set->main_size = n;
+    set->count = n;
+    return set;
+}
+
+void speedup_mutable_i64_free(speedup_mutable_i64_t* set) {
+    if (!set) return;
+    speedup_free(set->main);
+    speedup_free(set->next);
+    speedup_free(set->spare);
+    speedup_free(set->buffers);
+    free(set);
+}
+
+int speedup_mutable_i64_contains(const speedup_mutable_i64_t* set, int64_t key) {
+    if (frozen_has(set, key)) return !buffer_has(set->tomb, set->tomb_size, key);
+    return buffer_has(set->delta, set->delta_size, key);
+}
+
+int speedup_mutable_i64_insert(speedup_mutable_i64_t* set, int64_t key) {
+    if (ensure_room(set) != 0) return -1;
+    if (frozen_has(set, key)) {
+        if (!buffer_remove(set->tomb, &set->tomb_size, key)) return 0;
+    } else {
+        if (buffer_has(set->delta, set->delta_size, key)) return 0;
+        buffer_add(set->delta, &set->delta_size, key);
+    }
+    set->count++;
+    if (set->next) merge_advance(set, set->step);
+    return 1;
+}
+
+int speedup_mutable_i64_erase(speedup_mutable_i64_t* set, int64_t key) {
+    if (ensure_room(set) != 0) return -1;
+    if (!buffer_remove(set->delta, &set->delta_size, key)) {
+        if (!frozen_has(set, key) || buffer_has(set->tomb, set->tomb_size, key)) return 0;
+        buffer_add(set->tomb, &set->tomb_size, key);
+    }
+    set->count--;
+    if (set->next) merge_advance(set, set->step);
+    return 1;
+}
+
+int64_t speedup_mutable_i64_size(const speedup_mutable_i64_t* set) {
+    return set->count;
+}
+
+int speedup_mutable_i64_flush(speedup_mutable_i64_t* set) {
+    if (set->next) merge_advance(set, -1);
+    if (set->delta_size == 0 && set->tomb_size == 0) return 0;
+    if (merge_start(set) != 0) return -1;
+    merge_advance(set, -1);
+    return 0;
+}
+
+int64_t speedup_mutable_i64_buffer_capacity(const speedup_mutable_i64_t* set) {
+    return set->capacity;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/* NASM kernels linked into the library when SPEEDUP_ENABLE_ASM is on:
+ * binary_search_win64.asm on Windows, binary_search_sysv.asm elsewhere.
+ * Both files export the same kernels under ABI-suffixed names. */
+#if defined(_WIN32)
+#define SPEEDUP_ASM_KERNEL(name) name##_binary_search_win64
+#else
+#define SPEEDUP_ASM_KERNEL(name) name##_binary_search_sysv
+#endif
+
+int64_t SPEEDUP_ASM_KERNEL(branching)(const int64_t* array, int64_t key, int64_t size);
+int64_t SPEEDUP_ASM_KERNEL(branchless)(const int64_t* array, int64_t key, int64_t size);
+int64_t SPEEDUP_ASM_KERNEL(optimized)(const int64_t* array, int64_t key, int64_t size);
+
+/* Fixed-iteration CMOV bounds: first index with element >= key / > key. */
+int64_t SPEEDUP_ASM_KERNEL(lower_bound)(const int64_t* array, int64_t key, int64_t size);
+int64_t SPEEDUP_ASM_KERNEL(upper_bound)(const int64_t* array, int64_t key, int64_t size);
+
+/* Fixed-iteration CMOV search over records: key of record i at
+ * base + i * stride + key_offset; first match or -1. */
+int64_t SPEEDUP_ASM_KERNEL(strided)(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size);
@@ -0,0 +1,281 @@
+; System V AMD64 binary search implementations (Linux, BSD, macOS)
+; Ports of the kernels in binary_search_win64.asm.
+; Calling convention: RDI = first param, RSI = second param, RDX = third param
+; Volatile registers: RAX, RCX, RDX, RSI, RDI, R8-R11
+; Non-volatile registers: RBX, RBP, R12-R15 must be preserved
+; All kernels are leaf functions that only touch volatile registers, so no
+; prologue/epilogue is needed (the Win64 versions save RSI/RDI because they
+; are non-volatile there).
+
+%ifidn __OUTPUT_FORMAT__, macho64
+    %define SYM(name) _ %+ name
+%else
+    %define SYM(name) name
+%endif
+
+section .text
+
+; ============================================================================
+; Branching Binary Search for System V
+; ============================================================================
+global SYM(branching_binary_search_sysv)
+SYM(branching_binary_search_sysv):
+    ; RDI = array pointer, RSI = key, RDX = size
+    xor eax, eax        ; left = 0
+    lea r8, [rdx - 1]   ; right = size - 1
+
+.search_loop:
+    cmp rax, r8
+    jg .not_found
+
+    ; Calculate mid = (left + right) / 2
+    lea rcx, [rax + r8]
+    shr rcx, 1          ; rcx = mid
+
+    ; Load array[mid]
+    mov r9, [rdi + rcx*8]
+    cmp r9, rsi
+    je .found
+    jl .greater
+
+.less:
+    ; array[mid] > key
+    lea r8, [rcx - 1]
+    jmp .search_loop
+
+.greater:
+    ; array[mid] < key
+    lea rax, [rcx + 1]
+    jmp .search_loop
+
+.found:
+    mov rax, rcx
+    ret
+
+.not_found:
+    mov rax, -1
+    ret
+
+; ============================================================================
+; Branchless Binary Search for System V (CMOV)
+; ============================================================================
+global SYM(branchless_binary_search_sysv)
+SYM(branchless_binary_search_sysv):
+    ; RDI = array pointer, RSI = key, RDX = size
+    xor eax, eax        ; left = 0
+    lea r8, [rdx - 1]   ; right = size - 1
+
+.search_loop_cmov:
+    cmp rax, r8
+    jg .not_found_cmov
+
+    ; Calculate mid = (left + right) / 2
+    lea rcx, [rax + r8]
+    shr rcx, 1          ; rcx = mid
+
+    ; Load array[mid]
+    mov r9, [rdi + rcx*8]
+    cmp r9, rsi
+    je .found_cmov      ; Exit immediately on match
+
+    ; Prepare new bounds
+    lea r10, [rcx + 1]  ; mid + 1
+    lea r11, [rcx - 1]  ; mid - 1
+
+    ; Branchless updates
+    cmovl rax, r10      ; if array[mid] < key: left = mid + 1
+    cmovg r8, r11       ; if array[mid] > key: right = mid - 1
+
+    jmp .search_loop_cmov
+
+.found_cmov:
+    mov rax, rcx        ; return index
+    ret
+
+.not_found_cmov:
+    mov rax, -1
+    ret
+
+; ============================================================================
+; Optimized Binary Search with Software Pipelining for System V
+; ============================================================================
+global SYM(optimized_binary_search_sysv)
+SYM(optimized_binary_search_sysv):
+    ; RDI = array pointer, RSI = key, RDX = size
+    xor eax, eax        ; left = 0
+    lea r8, [rdx - 1]   ; right = size - 1
+
+    ; Check for empty array
+    cmp rax, r8
+    jg .not_found_opt
+
+    ; Prime the pipeline - load first mid value
+    lea rcx, [rax + r8]
+    shr rcx, 1
+    mov r9, [rdi + rcx*8]
+
+.search_loop_opt:
+    ; Value already loaded in r9 from previous iteration
+    cmp r9, rsi
+    je .found_opt
+    jl .greater_opt
+
+.less_opt:
+    ; array[mid] > key: search left half
+    lea r8, [rcx - 1]
+
+    ; Check if done
+    cmp rax, r8
+    jg .not_found_opt
+
+    ; Calculate next mid and load while updating bounds
+    lea rcx, [rax + r8]
+    shr rcx, 1
+    mov r9, [rdi + rcx*8]   ; Load for next iteration
+
+    jmp .search_loop_opt
+
+.greater_opt:
+    ; array[mid] < key: search right half
+    lea rax, [rcx + 1]
+
+    ; Check if done
+    cmp rax, r8
+    jg .not_found_opt
+
+    ; Calculate next mid and load while updating bounds
+    lea rcx, [rax + r8]
+    shr rcx, 1
+    mov r9, [rdi + rcx*8]   ; Load for next iteration
+
+    jmp .search_loop_opt
+
+.found_opt:
+    mov rax, rcx
+    ret
+
+.not_found_opt:
+    mov rax, -1
+    ret
+
+; ============================================================================
+; Fixed-iteration lower_bound / upper_bound for System V (CMOV)
+; ============================================================================
+; Return the first index whose element is >= key (lower) or > key (upper),
+; size when there is none. The loop runs ceil(log2(size)) times for every
+; key and has no early exit, so the only branch is the predictable loop test.
+global SYM(lower_bound_binary_search_sysv)
+SYM(lower_bound_binary_search_sysv):
+    ; RDI = array pointer, RSI = key, RDX = size
+    xor eax, eax        ; result 0 for empty arrays
+    test rdx, rdx
+    jle .done_lb
+    mov rcx, rdi        ; base = array
+
+.loop_lb:
+    cmp rdx, 1
+    jle .tail_lb
+    mov r8, rdx
+    shr r8, 1           ; half = len / 2
+    lea r9, [rcx + r8*8] ; base + half
+    sub rdx, r8         ; len -= half
+    cmp [r9], rsi
+    cmovl rcx, r9       ; if base[half] < key: base += half
+    jmp .loop_lb
+
+.tail_lb:
+    cmp [rcx], rsi
+    setl al             ; pos = base + (*base < key)
+    sub rcx, rdi
+    sar rcx, 3
+    add rax, rcx
+
+.done_lb:
+    ret
+
+global SYM(upper_bound_binary_search_sysv)
+SYM(upper_bound_binary_search_sysv):
+    ; RDI = array pointer, RSI = key, RDX = size
+    xor eax, eax
+    test rdx, rdx
+    jle .done_ub
+    mov rcx, rdi
+
+.loop_ub:
+    cmp rdx, 1
+    jle .tail_ub
+    mov r8, rdx
+    shr r8, 1
+    lea r9, [rcx + r8*8]
+    sub rdx, r8
+    cmp [r9], rsi
+    cmovle rcx, r9      ; if base[half] <= key: base += half
+    jmp .loop_ub
+
+.tail_ub:
+    cmp [rcx], rsi
+    setle al
+    sub rcx, rdi
+    sar rcx, 3
+    add rax, rcx
+
+.done_ub:
+    ret
+
+; ============================================================================
+; Strided search over records for System V (CMOV)
+; ============================================================================
+; The lower_bound loop over the key field of an array of records: the key of
+; record i is at base + key_offset + i * stride. The record pointer and its
+; index move together, so the loop still has one load and no data-dependent
+; branch; both possible next probes are prefetched, since with records each
+; probe is its own cache line. Returns the first index whose key equals key,
+; or -1.
+global SYM(strided_binary_search_sysv)
+SYM(strided_binary_search_sysv):
+    ; RDI = base, RSI = stride, RDX = key_offset, RCX = key, R8 = size
+    mov rax, -1
+    test r8, r8
+    jle .done_st
+    add rdi, rdx        ; ptr = key field of record 0
+    xor eax, eax        ; idx = 0
+    mov rdx, r8         ; len = size
+
+.loop_st:
+    cmp rdx, 1
+    jle .tail_st
+    mov r9, rdx
+    shr r9, 1           ; half = len / 2
+    sub rdx, r9         ; len -= half
+    lea r10, [rax + r9] ; idx + half
+    imul r9, rsi
+    mov r11, rdx
+    shr r11, 1
+    imul r11, rsi       ; next probe offset from either side
+    prefetcht0 [rdi + r11]
+    add r9, rdi         ; ptr + half * stride
+    prefetcht0 [r9 + r11]
+    cmp [r9], rcx
+    cmovl rdi, r9       ; if key[idx + half] < key: advance ptr and idx
+    cmovl rax, r10
+    jmp .loop_st
+
+.tail_st:
+    cmp [rdi], rcx
+    je .done_st
+    jg .miss_st
+    inc rax             ; first key >= key is the next record, if any
+    cmp rax, r8
+    jge .miss_st
+    cmp [rdi + rsi], rcx
+    je .done_st
+
+.miss_st:
+    mov rax, -1
+
+.done_st:
+    ret
+
+%ifidn __OUTPUT_FORMAT__, elf64
+section .note.GNU-stack noalloc noexec nowrite progbits
+%endif
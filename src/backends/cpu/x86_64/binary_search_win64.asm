@@ -249,6 +249,70 @@ optimized_binary_search_win64:
     pop rbx
     ret
 
+; ============================================================================
+; Fixed-iteration lower_bound / upper_bound for Windows x64 (CMOV)
+; ============================================================================
+; Return the first index whose element is >= key (lower) or > key (upper),
+; size when there is none. No early exit: the loop runs ceil(log2(size))
+; times. Only volatile registers are used, so nothing is saved.
+global lower_bound_binary_search_win64
+lower_bound_binary_search_win64:
+    ; RCX = array pointer, RDX = key, R8 = size
+    xor eax, eax        ; result 0 for empty arrays
+    test r8, r8
+    jle .done_lb
+    mov r10, rcx        ; base = array
+
+.loop_lb:
+    cmp r8, 1
+    jle .tail_lb
+    mov r9, r8
+    shr r9, 1           ; half = len / 2
+    lea r11, [r10 + r9*8] ; base + half
+    sub r8, r9          ; len -= half
+    cmp [r11], rdx
+    cmovl r10, r11      ; if base[half] < key: base += half
+    jmp .loop_lb
+
+.tail_lb:
+    cmp [r10], rdx
+    setl al             ; pos = base + (*base < key)
+    sub r10, rcx
+    sar r10, 3
+    add rax, r10
+
+.done_lb:
+    ret
+
+global upper_bound_binary_search_win64
+upper_bound_binary_search_win64:
+    ; RCX = array pointer, RDX = key, R8 = size
+    xor eax, eax
+    test r8, r8
+    jle .done_ub
+    mov r10, rcx
+
+.loop_ub:
+    cmp r8, 1
+    jle .tail_ub
+    mov r9, r8
+    shr r9, 1
+    lea r11, [r10 + r9*8]
+    sub r8, r9
+    cmp [r11], rdx
+    cmovle r10, r11     ; if base[half] <= key: base += half
+    jmp .loop_ub
+
+.tail_ub:
+    cmp [r10], rdx
+    setle al
+    sub r10, rcx
+    sar r10, 3
+    add rax, r10
+
+.done_ub:
+    ret
+
 ; ============================================================================
 ; Measure CPU Cycles for Windows x64 - FIXED
 ; ============================================================================
@@ -369,4 +433,56 @@ measure_cycles_with_result_win64:
     pop rdi
     pop rsi
     pop rbx
-    ret
\ No newline at end of file
+    ret
+
+; ============================================================================
+; Strided search over records for Windows x64 (CMOV)
+; ============================================================================
+; Same loop as the System V kernel. Size is the fifth argument, read from the
+; stack; RSI holds the prefetch offset and is saved.
+global strided_binary_search_win64
+strided_binary_search_win64:
+    ; RCX = base, RDX = stride, R8 = key_offset, R9 = key, [rsp+40] = size
+    push rsi            ; size now at [rsp+48]
+    mov rax, -1
+    cmp qword [rsp+48], 0
+    jle .done_st
+    add rcx, r8         ; ptr = key field of record 0
+    xor eax, eax        ; idx = 0
+    mov r8, [rsp+48]    ; len = size
+
+.loop_st:
+    cmp r8, 1
+    jle .tail_st
+    mov r10, r8
+    shr r10, 1          ; half = len / 2
+    sub r8, r10         ; len -= half
+    lea r11, [rax + r10] ; idx + half
+    imul r10, rdx
+    mov rsi, r8
+    shr rsi, 1
+    imul rsi, rdx       ; next probe offset from either side
+    prefetcht0 [rcx + rsi]
+    add r10, rcx        ; ptr + half * stride
+    prefetcht0 [r10 + rsi]
+    cmp [r10], r9
+    cmovl rcx, r10      ; if key[idx + half] < key: advance ptr and idx
+    cmovl rax, r11
+    jmp .loop_st
+
+.tail_st:
+    cmp [rcx], r9
+    je .done_st
+    jg .miss_st
+    inc rax             ; first key >= key is the next record, if any
+    cmp rax, [rsp+48]
+    jge .miss_st
+    cmp [rcx + rdx], r9
+    je .done_st
+
+.miss_st:
+    mov rax, -1
+
+.done_st:
+    pop rsi
+    ret
@@ -1 +1,5 @@
+#include "speedup/config.h"
 int speedup_cuda_available(void){return 0;}
+#if !SPEEDUP_ENABLE_CUDA
+int speedup_cuda_binary_search_stub(void){return -1;}
+#endif
@@ -1,3 +1,118 @@
+#include <stdatomic.h>
 #include <stdint.h>
-int speedup_cpu_has_avx2(void){return 0;}
-int speedup_cpu_has_neon(void){return 0;}
+#include "speedup/backend/cpu_features.h"
+#include "core/speedup_internal.h"
+
+#if SPEEDUP_X86_64
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_ASIMD
+#define HWCAP_ASIMD (1 << 1)
+#endif
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+#endif
+
+typedef struct speedup_cpu_info_t {
+    int avx2;
+    int avx512;
+    int bmi2;
+    int neon;
+    int sve;
+    uint32_t cacheline;
+} speedup_cpu_info_t;
+
+/* g_cpu_ready: 0 before detection, 1 while one caller detects, 2 once g_cpu
+ * is published. Only that caller writes g_cpu. */
+static speedup_cpu_info_t g_cpu;
+static _Atomic int g_cpu_ready = 0;
+
+#if SPEEDUP_X86_64
+static void cpuid(uint32_t leaf, uint32_t sub, uint32_t r[4]) {
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuidex(regs, (int)leaf, (int)sub);
+    for (int i = 0; i < 4; i++) r[i] = (uint32_t)regs[i];
+#else
+    __cpuid_count(leaf, sub, r[0], r[1], r[2], r[3]);
+#endif
+}
+
+static uint64_t xgetbv0(void) {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+static void detect(speedup_cpu_info_t* info) {
+    uint32_t r[4];
+    cpuid(0, 0, r);
+    uint32_t max_leaf = r[0];
+
+    cpuid(1, 0, r);
+    int osxsave = (r[2] >> 27) & 1;
+    uint32_t clflush = ((r[1] >> 8) & 0xff) * 8;
+    info->cacheline = clflush ? clflush : SPEEDUP_CACHELINE;
+
+    uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+    int os_avx = (xcr0 & 0x6) == 0x6;        /* XMM + YMM state */
+    int os_avx512 = (xcr0 & 0xe6) == 0xe6;   /* + opmask, ZMM_Hi256, Hi16_ZMM */
+
+    if (max_leaf >= 7) {
+        cpuid(7, 0, r);
+        info->avx2 = os_avx && ((r[1] >> 5) & 1);
+        info->bmi2 = (r[1] >> 8) & 1;
+        info->avx512 = os_avx512 && ((r[1] >> 16) & 1);
+    }
+}
+#else
+static void detect(speedup_cpu_info_t* info) {
+    info->cacheline = SPEEDUP_CACHELINE;
+#if defined(__aarch64__) || defined(_M_ARM64)
+    info->neon = 1;  /* Advanced SIMD is mandatory on AArch64 */
+#if defined(__linux__)
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    info->neon = (hwcap & HWCAP_ASIMD) != 0;
+    info->sve = (hwcap & HWCAP_SVE) != 0;
+#endif
+#if defined(__APPLE__)
+    info->cacheline = 128;
+#endif
+#endif
+}
+#endif
+
+static const speedup_cpu_info_t* cpu(void) {
+    if (atomic_load_explicit(&g_cpu_ready, memory_order_acquire) == 2) return &g_cpu;
+
+    int expected = 0;
+    if (atomic_compare_exchange_strong_explicit(&g_cpu_ready, &expected, 1, memory_order_acquire,
+                                                memory_order_acquire)) {
+        speedup_cpu_info_t info = {0, 0, 0, 0, 0, 0};
+        detect(&info);
+        g_cpu = info;
+        atomic_store_explicit(&g_cpu_ready, 2, memory_order_release);
+    }
+    while (atomic_load_explicit(&g_cpu_ready, memory_order_acquire) != 2) {
+    }
+    return &g_cpu;
+}
+
+int speedup_cpu_has_avx2(void){return cpu()->avx2;}
+int speedup_cpu_has_avx512(void){return cpu()->avx512;}
+int speedup_cpu_has_bmi2(void){return cpu()->bmi2;}
+int speedup_cpu_has_neon(void){return cpu()->neon;}
+int speedup_cpu_has_sve(void){return cpu()->sve;}
+uint32_t speedup_cpu_cacheline_bytes(void){return cpu()->cacheline;}
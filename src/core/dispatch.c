@@ -1,10 +1,40 @@
+#include <stdatomic.h>
 #include "speedup/backend/dispatch.h"
-static uint32_t g_threads = 0;
-static speedup_cache_hint_t g_cache = {32768,262144,8388608,64};
-static speedup_backend_pref_t g_pref = SPEEDUP_BACKEND_AUTO;
-void speedup_set_threads_hint(uint32_t n){g_threads=n;}
-void speedup_set_cache_hint(speedup_cache_hint_t hint){g_cache=hint;}
-void speedup_set_backend_preference(speedup_backend_pref_t pref){g_pref=pref;}
-uint32_t speedup_get_threads_hint(void){return g_threads;}
-speedup_cache_hint_t speedup_get_cache_hint(void){return g_cache;}
-speedup_backend_pref_t speedup_get_backend_preference(void){return g_pref;}
+#include "speedup/config.h"
+#include "algorithms/binary_search/kernel_table.h"
+/* Hints are public setters any thread may call while others search: the pool
+ * reads the threads hint from batch callers, and the mutable index reads the
+ * cache hint when it is created. */
+static _Atomic uint32_t g_threads = SPEEDUP_DEFAULT_THREADS;
+/* The cache hint is four words, published under a sequence count so readers
+ * never see two hints mixed: odd while a setter (serialized by g_cache_lock)
+ * is writing, and readers retry until they see the same even count twice. */
+static _Atomic uint32_t g_cache[4] = {SPEEDUP_DEFAULT_L1_BYTES,SPEEDUP_DEFAULT_L2_BYTES,SPEEDUP_DEFAULT_L3_BYTES,64};
+static _Atomic uint32_t g_cache_seq = 0;
+static atomic_flag g_cache_lock = ATOMIC_FLAG_INIT;
+/* Read by speedup_kernels_resolve, which lazy first calls can run on any thread. */
+static _Atomic speedup_backend_pref_t g_pref = SPEEDUP_BACKEND_AUTO;
+void speedup_set_threads_hint(uint32_t n){atomic_store_explicit(&g_threads,n,memory_order_relaxed);}
+void speedup_set_cache_hint(speedup_cache_hint_t hint){
+    uint32_t words[4] = {hint.l1_bytes,hint.l2_bytes,hint.l3_bytes,hint.cacheline_bytes};
+    while(atomic_flag_test_and_set_explicit(&g_cache_lock,memory_order_acquire)){}
+    uint32_t seq = atomic_load_explicit(&g_cache_seq,memory_order_relaxed);
+    atomic_store_explicit(&g_cache_seq,seq+1,memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    for(int i=0;i<4;i++) atomic_store_explicit(&g_cache[i],words[i],memory_order_relaxed);
+    atomic_store_explicit(&g_cache_seq,seq+2,memory_order_release);
+    atomic_flag_clear_explicit(&g_cache_lock,memory_order_release);
+}
+void speedup_set_backend_preference(speedup_backend_pref_t pref){atomic_store_explicit(&g_pref,pref,memory_order_relaxed);speedup_kernels_resolve();}
+uint32_t speedup_get_threads_hint(void){return atomic_load_explicit(&g_threads,memory_order_relaxed);}
+speedup_cache_hint_t speedup_get_cache_hint(void){
+    uint32_t words[4], seq;
+    do {
+        seq = atomic_load_explicit(&g_cache_seq,memory_order_acquire);
+        for(int i=0;i<4;i++) words[i] = atomic_load_explicit(&g_cache[i],memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+    } while((seq & 1) || atomic_load_explicit(&g_cache_seq,memory_order_relaxed) != seq);
+    speedup_cache_hint_t hint = {words[0],words[1],words[2],words[3]};
+    return hint;
+}
+speedup_backend_pref_t speedup_get_backend_preference(void){return atomic_load_explicit(&g_pref,memory_order_relaxed);}
@@ -0,0 +1,88 @@
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/speedup_internal.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <io.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* Temp files are named path.<pid>.<n>.tmp and created exclusively, so
+ * concurrent saves of one path, from this process or another, never share
+ * one; a stale name left by a crash is skipped. */
+#define SPEEDUP_TMP_ATTEMPTS 16
+
+static _Atomic uint32_t g_tmp_counter = 0;
+
+FILE* speedup_file_create_temp(const char* path, char** tmp) {
+    size_t len = strlen(path) + 48;
+    *tmp = (char*)malloc(len);
+    if (!*tmp) return NULL;
+#if defined(_WIN32)
+    unsigned long pid = (unsigned long)_getpid();
+#else
+    unsigned long pid = (unsigned long)getpid();
+#endif
+    for (int attempt = 0; attempt < SPEEDUP_TMP_ATTEMPTS; attempt++) {
+        uint32_t n = atomic_fetch_add_explicit(&g_tmp_counter, 1, memory_order_relaxed);
+        snprintf(*tmp, len, "%s.%lu.%u.tmp", path, pid, (unsigned)n);
+        FILE* f = fopen(*tmp, "wbx");
+        if (f) return f;
+    }
+    free(*tmp);
+    *tmp = NULL;
+    return NULL;
+}
+
+/* Flushes stdio and OS buffers, so the rename never publishes a file whose
+ * data is still only in memory. */
+static int sync_file(FILE* f) {
+    if (fflush(f) != 0) return 0;
+#if defined(_WIN32)
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+static int replace_file(const char* from, const char* to) {
+#if defined(_WIN32)
+    return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) ? 0 : -1;
+#else
+    if (rename(from, to) != 0) return -1;
+    /* Make the rename itself durable; failing here leaves a complete file in
+     * place, so it is not reported. */
+    const char* slash = strrchr(to, '/');
+    char dir[4096];
+    if (!slash) {
+        strcpy(dir, ".");
+    } else if ((size_t)(slash - to) < sizeof(dir)) {
+        size_t n = slash == to ? 1 : (size_t)(slash - to);
+        memcpy(dir, to, n);
+        dir[n] = '\0';
+    } else {
+        return 0;
+    }
+    int fd = open(dir, O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+    return 0;
+#endif
+}
+
+int speedup_file_commit_temp(FILE* f, char* tmp, const char* path, int ok) {
+    ok = ok && sync_file(f);
+    ok = fclose(f) == 0 && ok;
+    ok = ok && replace_file(tmp, path) == 0;
+    if (!ok) remove(tmp);
+    free(tmp);
+    return ok ? 0 : -1;
+}
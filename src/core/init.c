@@ -1,2 +1,31 @@
+#include <stdlib.h>
 #include "speedup/api.h"
-void speedup_init(void) {}
+#include "algorithms/binary_search/kernel_table.h"
+
+/* Largest array the startup calibration mode measures (64 MB of keys). */
+#define SPEEDUP_CALIBRATE_MAX_SIZE (1 << 23)
+
+/* SPEEDUP_TUNING_PROFILE=<path> loads a tuning profile. If the file cannot
+ * be loaded and SPEEDUP_CALIBRATE=1, the host is calibrated once and the
+ * profile is written there for later processes. */
+static void speedup_init_tuning(void) {
+    const char* profile = getenv("SPEEDUP_TUNING_PROFILE");
+    if (!profile || !*profile) return;
+    if (speedup_tuning_load(profile) == 0) return;
+
+    const char* calibrate = getenv("SPEEDUP_CALIBRATE");
+    if (calibrate && calibrate[0] == '1') {
+        if (speedup_calibrate(SPEEDUP_CALIBRATE_MAX_SIZE) == 0) {
+            speedup_tuning_save(profile);
+        }
+    }
+}
+
+void speedup_init(void) {
+    speedup_cache_hint_t cache = speedup_get_cache_hint();
+    cache.cacheline_bytes = speedup_cpu_cacheline_bytes();
+    speedup_set_cache_hint(cache);
+
+    speedup_init_tuning();
+    speedup_kernels_resolve();
+}
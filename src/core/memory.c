@@ -0,0 +1,216 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "speedup/backend/memory.h"
+#include "speedup/backend/numa.h"
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* Every block is preceded by a header in the SPEEDUP_ALLOC_ALIGN bytes before
+ * it, so speedup_free can tell heap blocks from mappings without a lookup.
+ * Heap blocks carry it in front of the user bytes. Huge-page blocks start on
+ * the page boundary and keep it in an ordinary page just below, so a block of
+ * exactly n huge pages takes n pages. */
+#define SPEEDUP_ALLOC_ALIGN 128
+#define SPEEDUP_SMALL_PAGE ((size_t)4096)
+#define SPEEDUP_HUGE_2M ((size_t)2 << 20)
+#define SPEEDUP_HUGE_1G ((size_t)1 << 30)
+#define SPEEDUP_MPOL_PREFERRED 1  /* linux/mempolicy.h */
+
+typedef struct speedup_alloc_header_t {
+    void* base;         /* start of the heap block or mapping */
+    size_t length;      /* mapping length; 0 for heap blocks */
+    size_t page_size;   /* see speedup_alloc_page_size */
+    size_t head_length; /* separate mapping holding the header, just below */
+} speedup_alloc_header_t;
+
+static _Atomic int g_page_policy = SPEEDUP_PAGES_AUTO;
+
+void speedup_set_page_policy(speedup_page_policy_t policy) {
+    atomic_store_explicit(&g_page_policy, (int)policy, memory_order_relaxed);
+}
+
+speedup_page_policy_t speedup_get_page_policy(void) {
+    return (speedup_page_policy_t)atomic_load_explicit(&g_page_policy, memory_order_relaxed);
+}
+
+/* Writes the header into the SPEEDUP_ALLOC_ALIGN bytes before user. */
+static void* finish(char* user, void* base, size_t length, size_t page_size) {
+    speedup_alloc_header_t* h = (speedup_alloc_header_t*)(user - SPEEDUP_ALLOC_ALIGN);
+    h->base = base;
+    h->length = length;
+    h->page_size = page_size;
+    h->head_length = 0;
+    return user;
+}
+
+static const speedup_alloc_header_t* header_of(const void* p) {
+    return (const speedup_alloc_header_t*)((const char*)p - SPEEDUP_ALLOC_ALIGN);
+}
+
+static speedup_alloc_header_t* header_of_mut(void* p) {
+    return (speedup_alloc_header_t*)((char*)p - SPEEDUP_ALLOC_ALIGN);
+}
+
+static size_t round_up(size_t n, size_t to) {
+    return (n + to - 1) / to * to;
+}
+
+#if defined(__linux__)
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+/* Explicit huge pages from the hugetlbfs pool; fails fast when none are
+ * reserved (vm.nr_hugepages) or the size is not configured. The huge range is
+ * placed inside an address reservation so that an ordinary page for the
+ * header fits right below it. */
+static void* map_hugetlb(size_t bytes, size_t page) {
+#if defined(MAP_HUGETLB)
+    size_t length = round_up(bytes, page);
+    size_t reserve = length + 2 * page;
+    char* r = (char*)mmap(NULL, reserve, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (r == (char*)MAP_FAILED) return NULL;
+
+    char* start = (char*)round_up((size_t)(uintptr_t)r + SPEEDUP_SMALL_PAGE, page);
+    char* head = start - SPEEDUP_SMALL_PAGE;
+    int log2_page = page == SPEEDUP_HUGE_1G ? 30 : 21;
+    if (mmap(start, length, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB | (log2_page << MAP_HUGE_SHIFT), -1,
+             0) == MAP_FAILED ||
+        mmap(head, SPEEDUP_SMALL_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) ==
+            MAP_FAILED) {
+        munmap(r, reserve);
+        return NULL;
+    }
+    if (head > r) munmap(r, (size_t)(head - r));
+    if (start + length < r + reserve) munmap(start + length, (size_t)(r + reserve - (start + length)));
+
+    void* user = finish(start, start, length, page);
+    header_of_mut(user)->head_length = SPEEDUP_SMALL_PAGE;
+    return user;
+#else
+    (void)bytes;
+    (void)page;
+    return NULL;
+#endif
+}
+
+/* Transparent huge pages: over-map so the block can start on a 2 MB boundary
+ * (THP only backs aligned 2 MB ranges) with room for the header below it,
+ * then advise the block's range. */
+static void* map_thp(size_t bytes) {
+    size_t huge = round_up(bytes, SPEEDUP_HUGE_2M);
+    size_t length = huge + SPEEDUP_HUGE_2M + SPEEDUP_SMALL_PAGE;
+    char* p = (char*)mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == (char*)MAP_FAILED) return NULL;
+
+    char* start = (char*)round_up((size_t)(uintptr_t)p + SPEEDUP_ALLOC_ALIGN, SPEEDUP_HUGE_2M);
+    size_t page = 0;
+#if defined(MADV_HUGEPAGE)
+    if (madvise(start, huge, MADV_HUGEPAGE) == 0) page = SPEEDUP_HUGE_2M;
+#endif
+    return finish(start, p, length, page);
+}
+
+/* Ordinary pages from a private mapping, for blocks that must not share
+ * pages with heap data (memory policies apply per page). */
+static void* map_small(size_t total) {
+    size_t length = round_up(total, SPEEDUP_SMALL_PAGE);
+    char* p = (char*)mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == (char*)MAP_FAILED) return NULL;
+    return finish(p + SPEEDUP_ALLOC_ALIGN, p, length, 0);
+}
+
+/* Sized by the caller's bytes alone: the header never needs huge pages. */
+static void* map_huge(size_t bytes) {
+    void* p = NULL;
+    /* 1 GB pages only when rounding up wastes at most an eighth. */
+    if (bytes >= SPEEDUP_HUGE_1G && round_up(bytes, SPEEDUP_HUGE_1G) - bytes <= bytes / 8) {
+        p = map_hugetlb(bytes, SPEEDUP_HUGE_1G);
+    }
+    if (!p) p = map_hugetlb(bytes, SPEEDUP_HUGE_2M);
+    if (!p) p = map_thp(bytes);
+    return p;
+}
+
+static int use_huge_pages(size_t bytes) {
+    return bytes >= SPEEDUP_HUGE_2M && speedup_get_page_policy() == SPEEDUP_PAGES_AUTO;
+}
+#endif
+
+void* speedup_alloc(size_t bytes) {
+    if (bytes > SIZE_MAX - SPEEDUP_ALLOC_ALIGN - 3 * SPEEDUP_HUGE_1G) return NULL;
+    size_t total = bytes + SPEEDUP_ALLOC_ALIGN;
+
+#if defined(__linux__)
+    if (use_huge_pages(bytes)) {
+        void* p = map_huge(bytes);
+        if (p) return p;
+    }
+#endif
+
+#if defined(_WIN32)
+    void* base = _aligned_malloc(total, SPEEDUP_ALLOC_ALIGN);
+    if (!base) return NULL;
+#else
+    void* base = NULL;
+    if (posix_memalign(&base, SPEEDUP_ALLOC_ALIGN, total) != 0) return NULL;
+#endif
+    return finish((char*)base + SPEEDUP_ALLOC_ALIGN, base, 0, 0);
+}
+
+void speedup_free(void* p) {
+    if (!p) return;
+    const speedup_alloc_header_t* h = header_of(p);
+#if defined(__linux__)
+    if (h->length) {
+        /* The header may live in the head mapping: read it all first. */
+        void* base = h->base;
+        size_t length = h->length;
+        size_t head_length = h->head_length;
+        munmap(base, length);
+        if (head_length) munmap((char*)base - head_length, head_length);
+        return;
+    }
+#endif
+#if defined(_WIN32)
+    _aligned_free(h->base);
+#else
+    free(h->base);
+#endif
+}
+
+void* speedup_alloc_on_node(size_t bytes, int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+    if (node < 0 || node >= SPEEDUP_NUMA_MAX_NODES) return speedup_alloc(bytes);
+    if (bytes > SIZE_MAX - SPEEDUP_ALLOC_ALIGN - 3 * SPEEDUP_HUGE_1G) return NULL;
+    size_t total = bytes + SPEEDUP_ALLOC_ALIGN;
+
+    void* p = use_huge_pages(bytes) ? map_huge(bytes) : NULL;
+    if (!p) p = map_small(total);
+    if (!p) return NULL;
+
+    /* Preferred rather than strict binding, so a full node spills over
+     * instead of failing; the pages are untouched, so it applies to all. */
+    const speedup_alloc_header_t* h = header_of(p);
+    unsigned long mask[SPEEDUP_NUMA_MAX_NODES / (8 * sizeof(unsigned long)) + 1] = {0};
+    mask[node / (8 * sizeof(unsigned long))] = 1ul << (node % (8 * sizeof(unsigned long)));
+    (void)syscall(SYS_mbind, h->base, h->length, SPEEDUP_MPOL_PREFERRED, mask,
+                  (unsigned long)SPEEDUP_NUMA_MAX_NODES + 1, 0ul);
+    return p;
+#else
+    (void)node;
+    return speedup_alloc(bytes);
+#endif
+}
+
+size_t speedup_alloc_page_size(const void* p) {
+    return p ? header_of(p)->page_size : 0;
+}
@@ -0,0 +1,218 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* sched_getcpu, CPU_SET */
+#endif
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "speedup/backend/numa.h"
+#include "core/speedup_internal.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+#define SPEEDUP_NUMA_MAX_CPUS 4096
+#define SPEEDUP_NUMA_REFRESH 1024
+
+typedef struct numa_topology_t {
+    int nodes;
+    int fake;
+    int16_t cpu_node[SPEEDUP_NUMA_MAX_CPUS];  /* -1: CPU not listed */
+} numa_topology_t;
+
+static numa_topology_t g_detected;
+static numa_topology_t g_fake;
+static _Atomic(const numa_topology_t*) g_topology = NULL;
+static _Atomic int g_detect_state = 0;  /* 0 none, 1 running, 2 done */
+static _Atomic unsigned g_generation = 1;
+static _Atomic int g_replication = 0;
+
+/* Per-thread cache of the current node; generation invalidates it when the
+ * topology is replaced. */
+typedef struct numa_thread_t {
+    unsigned generation;
+    int node;
+    int bound;
+    uint32_t calls;
+} numa_thread_t;
+
+static SPEEDUP_THREAD_LOCAL numa_thread_t t_numa;
+
+static void topology_clear(numa_topology_t* t) {
+    t->nodes = 0;
+    t->fake = 0;
+    for (int i = 0; i < SPEEDUP_NUMA_MAX_CPUS; i++) t->cpu_node[i] = -1;
+}
+
+/* Parses one CPU list ("0-3,8,10-11") into node; stops at ';' or the end.
+ * Returns the end of the list, or NULL on malformed input. */
+static const char* parse_cpulist(const char* s, numa_topology_t* t, int node) {
+    while (*s && *s != ';' && *s != '\n') {
+        char* end;
+        long lo = strtol(s, &end, 10);
+        if (end == s || lo < 0) return NULL;
+        long hi = lo;
+        s = end;
+        if (*s == '-') {
+            hi = strtol(s + 1, &end, 10);
+            if (end == s + 1 || hi < lo) return NULL;
+            s = end;
+        }
+        for (long cpu = lo; cpu <= hi && cpu < SPEEDUP_NUMA_MAX_CPUS; cpu++) {
+            if (t->cpu_node[cpu] < 0) t->cpu_node[cpu] = (int16_t)node;
+        }
+        if (*s == ',') s++;
+        else if (*s && *s != ';' && *s != '\n') return NULL;
+    }
+    return s;
+}
+
+static void detect(numa_topology_t* t) {
+    topology_clear(t);
+#if defined(__linux__)
+    /* Node ids may be sparse; nodes covers the highest one present. */
+    for (int node = 0; node < SPEEDUP_NUMA_MAX_NODES; node++) {
+        char path[64];
+        char list[4096];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE* f = fopen(path, "r");
+        if (!f) continue;
+        size_t len = fread(list, 1, sizeof(list) - 1, f);
+        fclose(f);
+        list[len] = '\0';
+        if (parse_cpulist(list, t, node)) t->nodes = node + 1;
+    }
+#endif
+    if (t->nodes < 1) t->nodes = 1;
+}
+
+static const numa_topology_t* topology(void) {
+    const numa_topology_t* t = atomic_load_explicit(&g_topology, memory_order_acquire);
+    if (t) return t;
+
+    int expected = 0;
+    if (atomic_compare_exchange_strong(&g_detect_state, &expected, 1)) {
+        const char* spec = getenv("SPEEDUP_NUMA_TOPOLOGY");
+        if (!spec || speedup_numa_set_topology(spec) != 0) {
+            detect(&g_detected);
+            const numa_topology_t* none = NULL;
+            atomic_compare_exchange_strong(&g_topology, &none, &g_detected);
+        }
+        atomic_store(&g_detect_state, 2);
+    }
+    while (atomic_load(&g_detect_state) != 2) {
+#if defined(_WIN32)
+        SwitchToThread();
+#elif defined(__linux__)
+        sched_yield();
+#endif
+    }
+    return atomic_load_explicit(&g_topology, memory_order_acquire);
+}
+
+int speedup_numa_set_topology(const char* spec) {
+    if (!spec) {
+        if (g_detected.nodes == 0) detect(&g_detected);
+        atomic_store_explicit(&g_topology, &g_detected, memory_order_release);
+        atomic_fetch_add(&g_generation, 1);
+        return 0;
+    }
+
+    /* Replaced in place: meant for tests and startup, not while other
+     * threads are routing lookups. */
+    numa_topology_t parsed;
+    topology_clear(&parsed);
+    const char* s = spec;
+    for (int node = 0;; node++) {
+        if (node == SPEEDUP_NUMA_MAX_NODES) return -1;
+        s = parse_cpulist(s, &parsed, node);
+        if (!s) return -1;
+        parsed.nodes = node + 1;
+        if (*s != ';') break;
+        s++;
+    }
+    parsed.fake = 1;
+    g_fake = parsed;
+    atomic_store_explicit(&g_topology, &g_fake, memory_order_release);
+    atomic_fetch_add(&g_generation, 1);
+    return 0;
+}
+
+int speedup_numa_node_count(void) {
+    return topology()->nodes;
+}
+
+int speedup_numa_nodes_are_physical(void) {
+    return !topology()->fake;
+}
+
+static int current_cpu(void) {
+#if defined(_WIN32)
+    return (int)GetCurrentProcessorNumber();
+#elif defined(__linux__)
+    int cpu = sched_getcpu();
+    return cpu >= 0 ? cpu : 0;
+#else
+    return 0;
+#endif
+}
+
+int speedup_numa_current_node(void) {
+    const numa_topology_t* t = topology();
+    if (t->nodes <= 1) return 0;
+
+    numa_thread_t* self = &t_numa;
+    unsigned generation = atomic_load_explicit(&g_generation, memory_order_relaxed);
+    if (self->generation == generation && (self->bound || (self->calls++ % SPEEDUP_NUMA_REFRESH) != 0)) {
+        return self->node;
+    }
+    if (self->generation != generation) {
+        self->generation = generation;
+        self->bound = 0;
+        self->calls = 1;
+    }
+    int cpu = current_cpu();
+    int node = cpu < SPEEDUP_NUMA_MAX_CPUS ? t->cpu_node[cpu] : -1;
+    self->node = node >= 0 && node < t->nodes ? node : 0;
+    return self->node;
+}
+
+int speedup_numa_bind_thread(int node) {
+    const numa_topology_t* t = topology();
+    if (node < 0 || node >= t->nodes) return -1;
+
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    int any = 0;
+    for (int cpu = 0; cpu < SPEEDUP_NUMA_MAX_CPUS && cpu < CPU_SETSIZE; cpu++) {
+        if (t->cpu_node[cpu] == node) {
+            CPU_SET(cpu, &set);
+            any = 1;
+        }
+    }
+    if (any) (void)sched_setaffinity(0, sizeof(set), &set);
+#elif defined(_WIN32)
+    DWORD_PTR mask = 0;
+    for (int cpu = 0; cpu < (int)(8 * sizeof(mask)); cpu++) {
+        if (t->cpu_node[cpu] == node) mask |= (DWORD_PTR)1 << cpu;
+    }
+    if (mask) (void)SetThreadAffinityMask(GetCurrentThread(), mask);
+#endif
+
+    t_numa.generation = atomic_load_explicit(&g_generation, memory_order_relaxed);
+    t_numa.node = node;
+    t_numa.bound = 1;
+    return 0;
+}
+
+void speedup_set_numa_replication(int enabled) {
+    atomic_store_explicit(&g_replication, enabled != 0, memory_order_relaxed);
+}
+
+int speedup_get_numa_replication(void) {
+    return atomic_load_explicit(&g_replication, memory_order_relaxed);
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SPEEDUP_PREFETCH(addr) __builtin_prefetch((const void*)(addr), 0, 3)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define SPEEDUP_PREFETCH(addr) _mm_prefetch((const char*)(addr), _MM_HINT_T0)
+#else
+#define SPEEDUP_PREFETCH(addr) ((void)(addr))
+#endif
+
+#define SPEEDUP_CACHELINE 64
+
+#if defined(_MSC_VER)
+#define SPEEDUP_THREAD_LOCAL __declspec(thread)
+#else
+#define SPEEDUP_THREAD_LOCAL _Thread_local
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SPEEDUP_X86_64 1
+#else
+#define SPEEDUP_X86_64 0
+#endif
+
+/* Per-function ISA enablement so AVX2 kernels build without global -mavx2
+ * and are only entered after a runtime speedup_cpu_has_avx2() check. */
+#if SPEEDUP_X86_64 && (defined(__GNUC__) || defined(__clang__))
+#define SPEEDUP_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#else
+#define SPEEDUP_TARGET_AVX2
+#endif
+
+static inline int speedup_ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return (int)i;
+#else
+    int n = 0;
+    while (!(x & 1)) { x >>= 1; n++; }
+    return n;
+#endif
+}
+
+static inline int speedup_popcount32(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(x);
+#elif defined(_MSC_VER) && SPEEDUP_X86_64
+    return (int)__popcnt(x);
+#else
+    int n = 0;
+    while (x) { x &= x - 1; n++; }
+    return n;
+#endif
+}
+
+/* Whether NUMA node ids name real nodes that memory can be bound to, rather
+ * than a fake topology (core/numa.c). */
+int speedup_numa_nodes_are_physical(void);
+
+/* 1 when keys[0..n) is non-decreasing (binary_search_batch.c). */
+int speedup_keys_sorted_i64(const int64_t* keys, int64_t n);
+
+/* Crash-safe file replacement (core/file.c): speedup_file_create_temp opens a
+ * temp file unique to this save next to path and stores its malloc'd name in
+ * *tmp, or returns NULL. speedup_file_commit_temp then takes f and tmp: when
+ * ok, it syncs the data and renames the file over path; otherwise, or if that
+ * fails, it removes the temp file. Returns 0 once path holds the new file. */
+FILE* speedup_file_create_temp(const char* path, char** tmp);
+int speedup_file_commit_temp(FILE* f, char* tmp, const char* path, int ok);
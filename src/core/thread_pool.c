@@ -0,0 +1,339 @@
+#include "core/thread_pool.h"
+#include "speedup/backend/dispatch.h"
+#include "speedup/backend/numa.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef HANDLE speedup_thread_t;
+typedef CRITICAL_SECTION speedup_mutex_t;
+typedef CONDITION_VARIABLE speedup_cond_t;
+#define speedup_mutex_init(m) InitializeCriticalSection(m)
+#define speedup_mutex_destroy(m) DeleteCriticalSection(m)
+#define speedup_mutex_lock(m) EnterCriticalSection(m)
+#define speedup_mutex_unlock(m) LeaveCriticalSection(m)
+#define speedup_cond_init(c) InitializeConditionVariable(c)
+#define speedup_cond_destroy(c) ((void)(c))
+#define speedup_cond_wait(c, m) SleepConditionVariableCS(c, m, INFINITE)
+#define speedup_cond_broadcast(c) WakeAllConditionVariable(c)
+#define speedup_yield() SwitchToThread()
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+typedef pthread_t speedup_thread_t;
+typedef pthread_mutex_t speedup_mutex_t;
+typedef pthread_cond_t speedup_cond_t;
+#define speedup_mutex_init(m) pthread_mutex_init(m, NULL)
+#define speedup_mutex_destroy(m) pthread_mutex_destroy(m)
+#define speedup_mutex_lock(m) pthread_mutex_lock(m)
+#define speedup_mutex_unlock(m) pthread_mutex_unlock(m)
+#define speedup_cond_init(c) pthread_cond_init(c, NULL)
+#define speedup_cond_destroy(c) pthread_cond_destroy(c)
+#define speedup_cond_wait(c, m) pthread_cond_wait(c, m)
+#define speedup_cond_broadcast(c) pthread_cond_broadcast(c)
+#define speedup_yield() sched_yield()
+#endif
+
+/* Each worker owns a deque of chunk indices packed as (top << 32 | bottom).
+ * A job only ever removes chunks, so the owner pops from the bottom and
+ * thieves take from the top with the same CAS; no task storage is needed
+ * and nothing is allocated per job. */
+typedef struct speedup_pool_t speedup_pool_t;
+
+typedef struct speedup_worker_t {
+    _Alignas(64) _Atomic uint64_t range;
+    uint32_t id;
+    int node;                   /* NUMA node to bind to, -1 for none */
+    speedup_pool_t* pool;
+    speedup_thread_t thread;
+} speedup_worker_t;
+
+struct speedup_pool_t {
+    uint32_t requested;         /* effective threads hint the pool was built for */
+    int nodes;                  /* NUMA nodes the workers were spread over */
+    uint32_t size;              /* workers including the calling thread */
+    speedup_worker_t* workers;  /* workers[0] belongs to the caller */
+
+    atomic_flag busy;           /* one job at a time, never re-entered */
+    speedup_mutex_t lock;
+    speedup_cond_t wake;
+    uint64_t generation;
+    int stop;
+
+    speedup_task_fn fn;
+    void* ctx;
+    int64_t n;
+    int64_t grain;
+    _Atomic int64_t pending;    /* chunks not yet finished */
+    _Atomic uint32_t active;    /* workers still inside the current job */
+};
+
+static speedup_pool_t* g_pool = NULL;
+static speedup_mutex_t g_pool_lock;
+static atomic_flag g_pool_lock_init = ATOMIC_FLAG_INIT;
+static _Atomic int g_pool_lock_ready = 0;
+
+static int deque_pop(speedup_worker_t* w, uint32_t* chunk) {
+    uint64_t r = atomic_load_explicit(&w->range, memory_order_acquire);
+    for (;;) {
+        uint32_t top = (uint32_t)(r >> 32), bottom = (uint32_t)r;
+        if (top >= bottom) return 0;
+        uint64_t next = ((uint64_t)top << 32) | (bottom - 1);
+        if (atomic_compare_exchange_weak_explicit(&w->range, &r, next, memory_order_acq_rel, memory_order_acquire)) {
+            *chunk = bottom - 1;
+            return 1;
+        }
+    }
+}
+
+static int deque_steal(speedup_worker_t* w, uint32_t* chunk) {
+    uint64_t r = atomic_load_explicit(&w->range, memory_order_acquire);
+    for (;;) {
+        uint32_t top = (uint32_t)(r >> 32), bottom = (uint32_t)r;
+        if (top >= bottom) return 0;
+        uint64_t next = ((uint64_t)(top + 1) << 32) | bottom;
+        if (atomic_compare_exchange_weak_explicit(&w->range, &r, next, memory_order_acq_rel, memory_order_acquire)) {
+            *chunk = top;
+            return 1;
+        }
+    }
+}
+
+static void run_chunk(speedup_pool_t* pool, uint32_t chunk) {
+    int64_t begin = (int64_t)chunk * pool->grain;
+    int64_t end = begin + pool->grain;
+    if (end > pool->n) end = pool->n;
+    pool->fn(pool->ctx, begin, end);
+    atomic_fetch_sub_explicit(&pool->pending, 1, memory_order_release);
+}
+
+static void participate(speedup_pool_t* pool, uint32_t self) {
+    uint32_t chunk;
+    while (deque_pop(&pool->workers[self], &chunk)) {
+        run_chunk(pool, chunk);
+    }
+    for (uint32_t i = 1; i < pool->size; i++) {
+        speedup_worker_t* victim = &pool->workers[(self + i) % pool->size];
+        while (deque_steal(victim, &chunk)) {
+            run_chunk(pool, chunk);
+        }
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI worker_main(LPVOID arg)
+#else
+static void* worker_main(void* arg)
+#endif
+{
+    speedup_worker_t* self = (speedup_worker_t*)arg;
+    speedup_pool_t* pool = self->pool;
+    uint64_t seen = 0;
+
+    if (self->node >= 0) speedup_numa_bind_thread(self->node);
+
+    for (;;) {
+        speedup_mutex_lock(&pool->lock);
+        while (pool->generation == seen && !pool->stop) {
+            speedup_cond_wait(&pool->wake, &pool->lock);
+        }
+        seen = pool->generation;
+        int stop = pool->stop;
+        speedup_mutex_unlock(&pool->lock);
+        if (stop) break;
+
+        participate(pool, self->id);
+        atomic_fetch_sub_explicit(&pool->active, 1, memory_order_release);
+    }
+    return 0;
+}
+
+static uint32_t hardware_threads(void) {
+    static _Atomic uint32_t cached = 0;
+    uint32_t n = atomic_load_explicit(&cached, memory_order_relaxed);
+    if (n) return n;
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    n = info.dwNumberOfProcessors > 0 ? (uint32_t)info.dwNumberOfProcessors : 1;
+#else
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    n = online > 0 ? (uint32_t)online : 1;
+#endif
+    atomic_store_explicit(&cached, n, memory_order_relaxed);
+    return n;
+}
+
+uint32_t speedup_get_effective_threads(void) {
+    uint32_t hint = speedup_get_threads_hint();
+    return hint ? hint : hardware_threads();
+}
+
+static void pool_lock_global(void) {
+    if (!atomic_load_explicit(&g_pool_lock_ready, memory_order_acquire)) {
+        if (!atomic_flag_test_and_set(&g_pool_lock_init)) {
+            speedup_mutex_init(&g_pool_lock);
+            atomic_store_explicit(&g_pool_lock_ready, 1, memory_order_release);
+        }
+        while (!atomic_load_explicit(&g_pool_lock_ready, memory_order_acquire)) {
+            speedup_yield();
+        }
+    }
+    speedup_mutex_lock(&g_pool_lock);
+}
+
+static void pool_destroy(speedup_pool_t* pool) {
+    speedup_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    speedup_cond_broadcast(&pool->wake);
+    speedup_mutex_unlock(&pool->lock);
+
+    for (uint32_t i = 1; i < pool->size; i++) {
+#if defined(_WIN32)
+        WaitForSingleObject(pool->workers[i].thread, INFINITE);
+        CloseHandle(pool->workers[i].thread);
+#else
+        pthread_join(pool->workers[i].thread, NULL);
+#endif
+    }
+
+    speedup_cond_destroy(&pool->wake);
+    speedup_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+static speedup_pool_t* pool_create(uint32_t size) {
+    speedup_pool_t* pool = (speedup_pool_t*)calloc(1, sizeof(*pool));
+    if (!pool) return NULL;
+    pool->workers = (speedup_worker_t*)calloc(size, sizeof(speedup_worker_t));
+    if (!pool->workers) {
+        free(pool);
+        return NULL;
+    }
+    pool->requested = size;
+    pool->size = size;
+    pool->nodes = speedup_numa_node_count();
+    atomic_flag_clear(&pool->busy);
+    speedup_mutex_init(&pool->lock);
+    speedup_cond_init(&pool->wake);
+    /* Contiguous worker ids share a node, so neighbouring deques (the first
+     * steal victims) are usually local. Fixed here, before any worker runs,
+     * so workers never read the pool size, which may still shrink. */
+    for (uint32_t i = 0; i < size; i++) {
+        pool->workers[i].id = i;
+        pool->workers[i].node = pool->nodes > 1 ? (int)((uint64_t)i * (uint64_t)pool->nodes / size) : -1;
+        pool->workers[i].pool = pool;
+        atomic_init(&pool->workers[i].range, 0);
+    }
+    atomic_init(&pool->pending, 0);
+    atomic_init(&pool->active, 0);
+    return pool;
+}
+
+/* Starts the worker threads; if the OS refuses some, the pool shrinks to the
+ * threads that did start. Workers only read size in participate, after taking
+ * pool->lock for their first job, so publishing it under the lock once every
+ * thread is created orders the write before those reads. */
+static void pool_start_workers(speedup_pool_t* pool) {
+    uint32_t size = pool->size;
+    uint32_t started = 1;
+    for (; started < size; started++) {
+#if defined(_WIN32)
+        pool->workers[started].thread = CreateThread(NULL, 0, worker_main, &pool->workers[started], 0, NULL);
+        if (!pool->workers[started].thread) break;
+#else
+        if (pthread_create(&pool->workers[started].thread, NULL, worker_main, &pool->workers[started]) != 0) break;
+#endif
+    }
+    if (started == size) return;
+    speedup_mutex_lock(&pool->lock);
+    pool->size = started;
+    speedup_mutex_unlock(&pool->lock);
+}
+
+/* Returns the pool sized for the current threads hint, (re)starting it when
+ * the hint or the NUMA topology changed. Called with g_pool_lock held. */
+static speedup_pool_t* pool_acquire(void) {
+    uint32_t size = speedup_get_effective_threads();
+    if (g_pool && g_pool->requested == size && g_pool->nodes == speedup_numa_node_count()) return g_pool;
+
+    if (g_pool) {
+        /* Jobs claim the pool while holding g_pool_lock, so once the running
+         * job (if any) finishes nobody else can start one on it. */
+        while (atomic_flag_test_and_set_explicit(&g_pool->busy, memory_order_acquire)) {
+            speedup_yield();
+        }
+        pool_destroy(g_pool);
+        g_pool = NULL;
+    }
+    if (size <= 1) return NULL;
+
+    g_pool = pool_create(size);
+    if (g_pool) pool_start_workers(g_pool);
+    return g_pool;
+}
+
+void speedup_parallel_for(int64_t n, int64_t grain, speedup_task_fn fn, void* ctx) {
+    if (n <= 0) return;
+    if (grain < 1) grain = 1;
+    if (n / grain >= INT32_MAX) grain = n / INT32_MAX + 1;
+
+    int64_t chunks = (n + grain - 1) / grain;
+    if (chunks <= 1) {
+        fn(ctx, 0, n);
+        return;
+    }
+
+    pool_lock_global();
+    speedup_pool_t* pool = pool_acquire();
+    if (!pool || pool->size <= 1 || atomic_flag_test_and_set_explicit(&pool->busy, memory_order_acquire)) {
+        speedup_mutex_unlock(&g_pool_lock);
+        fn(ctx, 0, n);
+        return;
+    }
+    speedup_mutex_unlock(&g_pool_lock);
+
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->n = n;
+    pool->grain = grain;
+    atomic_store_explicit(&pool->pending, chunks, memory_order_relaxed);
+    for (uint32_t i = 0; i < pool->size; i++) {
+        uint64_t top = (uint64_t)chunks * i / pool->size;
+        uint64_t bottom = (uint64_t)chunks * (i + 1) / pool->size;
+        atomic_store_explicit(&pool->workers[i].range, (top << 32) | bottom, memory_order_relaxed);
+    }
+    atomic_store_explicit(&pool->active, pool->size - 1, memory_order_relaxed);
+
+    speedup_mutex_lock(&pool->lock);
+    pool->generation++;
+    speedup_cond_broadcast(&pool->wake);
+    speedup_mutex_unlock(&pool->lock);
+
+    participate(pool, 0);
+
+    /* Wait for stolen chunks to finish and for every worker to leave the job,
+     * so the deques can be reused by the next call. */
+    while (atomic_load_explicit(&pool->pending, memory_order_acquire) > 0 ||
+           atomic_load_explicit(&pool->active, memory_order_acquire) > 0) {
+        speedup_yield();
+    }
+
+    atomic_flag_clear_explicit(&pool->busy, memory_order_release);
+}
+
+void speedup_thread_pool_shutdown(void) {
+    pool_lock_global();
+    if (g_pool) {
+        while (atomic_flag_test_and_set_explicit(&g_pool->busy, memory_order_acquire)) {
+            speedup_yield();
+        }
+        pool_destroy(g_pool);
+        g_pool = NULL;
+    }
+    speedup_mutex_unlock(&g_pool_lock);
+}
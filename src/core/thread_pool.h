@@ -0,0 +1,13 @@
+#pragma once
+#include <stdint.h>
+
+/* Chunk body for speedup_parallel_for: processes [begin, end). */
+typedef void (*speedup_task_fn)(void* ctx, int64_t begin, int64_t end);
+
+/* Runs fn over [0, n) in chunks of at most grain items on the shared
+ * work-stealing pool; the calling thread participates and the call returns
+ * once every chunk has run. Falls back to a serial loop when the pool has a
+ * single thread or is already running another job. */
+void speedup_parallel_for(int64_t n, int64_t grain, speedup_task_fn fn, void* ctx);
+
+void speedup_thread_pool_shutdown(void);
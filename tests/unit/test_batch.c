@@ -0,0 +1,50 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "speedup/api.h"
+
+static int cmp_i64(const void* a, const void* b) {
+    int64_t x = *(const int64_t*)a, y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+int main(void) {
+    int64_t sizes[] = {0, 1, 2, 3, 16, 17, 100, 1000, 65537};
+    int64_t n = 1000;
+    int64_t* a = (int64_t*)malloc(65537 * sizeof(int64_t));
+    int64_t* keys = (int64_t*)malloc(n * sizeof(int64_t));
+    int64_t* out = (int64_t*)malloc(n * sizeof(int64_t));
+    for (int64_t i = 0; i < 65537; i++) a[i] = i * 2;
+
+    srand(12345);
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        int64_t size = sizes[s];
+        for (int64_t i = 0; i < n; i++) keys[i] = rand() % (2 * size + 4) - 2;
+
+        /* Odd batch lengths exercise the partial trailing group. */
+        for (int64_t m = 0; m <= n; m += 333) {
+            speedup_binary_search_i64_batch(a, size, keys, m, out);
+            for (int64_t i = 0; i < m; i++) {
+                assert(out[i] == speedup_binary_search_i64_ref(a, keys[i], size));
+            }
+        }
+
+        /* Sorted batches, including repeated keys: sparse (m keys) and dense. */
+        qsort(keys, (size_t)n, sizeof(int64_t), cmp_i64);
+        for (int64_t m = 0; m <= n; m += 333) {
+            speedup_binary_search_i64_batch(a, size, keys, m, out);
+            for (int64_t i = 0; i < m; i++) {
+                assert(out[i] == speedup_binary_search_i64_ref(a, keys[i], size));
+            }
+            speedup_binary_search_i64_batch_sorted(a, size, keys + n - m, m, out);
+            for (int64_t i = 0; i < m; i++) {
+                assert(out[i] == speedup_binary_search_i64_ref(a, keys[n - m + i], size));
+            }
+        }
+    }
+
+    free(a);
+    free(keys);
+    free(out);
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "speedup/api.h"
+
+typedef int64_t (*bound_fn)(const int64_t* array, int64_t key, int64_t size);
+
+static int64_t linear_lower(const int64_t* a, int64_t size, int64_t key) {
+    int64_t i = 0;
+    while (i < size && a[i] < key) i++;
+    return i;
+}
+
+static int64_t linear_upper(const int64_t* a, int64_t size, int64_t key) {
+    int64_t i = 0;
+    while (i < size && a[i] <= key) i++;
+    return i;
+}
+
+int main(void) {
+    bound_fn lower[] = {speedup_lower_bound_i64, speedup_lower_bound_i64_ref,
+                        speedup_lower_bound_i64_branchless, speedup_lower_bound_i64_simd};
+    bound_fn upper[] = {speedup_upper_bound_i64, speedup_upper_bound_i64_ref,
+                        speedup_upper_bound_i64_branchless, speedup_upper_bound_i64_simd};
+    int64_t sizes[] = {0, 1, 2, 3, 15, 16, 17, 33, 100, 1000, 4097};
+    int64_t* a = (int64_t*)malloc(4097 * sizeof(int64_t));
+    int64_t* keys = (int64_t*)malloc(8300 * sizeof(int64_t));
+    int64_t* first = (int64_t*)malloc(8300 * sizeof(int64_t));
+    int64_t* last = (int64_t*)malloc(8300 * sizeof(int64_t));
+
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        int64_t size = sizes[s];
+        /* Runs of 1..4 equal keys with gaps, including the int64 extremes. */
+        for (int64_t i = 0; i < size; i++) a[i] = (i - i % 4 + i % 3) * 2 - size;
+        for (int64_t i = 1; i < size; i++) if (a[i] < a[i - 1]) a[i] = a[i - 1];
+        if (size > 0) a[0] = INT64_MIN;
+        if (size > 1) a[size - 1] = INT64_MAX;
+
+        int64_t n = 0;
+        keys[n++] = INT64_MIN;
+        keys[n++] = INT64_MAX;
+        for (int64_t key = -size - 4; key <= size + 4; key++) keys[n++] = key;
+
+        for (int64_t i = 0; i < n; i++) {
+            int64_t lo = linear_lower(a, size, keys[i]);
+            int64_t hi = linear_upper(a, size, keys[i]);
+            for (int k = 0; k < 4; k++) {
+                assert(lower[k](a, keys[i], size) == lo);
+                assert(upper[k](a, keys[i], size) == hi);
+            }
+            int64_t f, l;
+            speedup_equal_range_i64(a, keys[i], size, &f, &l);
+            assert(f == lo && l == hi);
+        }
+
+        speedup_equal_range_i64_batch(a, size, keys, n, first, last);
+        for (int64_t i = 0; i < n; i++) {
+            assert(first[i] == linear_lower(a, size, keys[i]));
+            assert(last[i] == linear_upper(a, size, keys[i]));
+        }
+        speedup_lower_bound_i64_batch(a, size, keys, n, first);
+        speedup_upper_bound_i64_batch(a, size, keys, n, last);
+        for (int64_t i = 0; i < n; i++) {
+            assert(first[i] == linear_lower(a, size, keys[i]));
+            assert(last[i] == linear_upper(a, size, keys[i]));
+        }
+    }
+
+    free(a);
+    free(keys);
+    free(first);
+    free(last);
+    return 0;
+}
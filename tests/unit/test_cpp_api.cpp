@@ -0,0 +1,146 @@
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "speedup/api.h"
+#include "speedup/speedup.hpp"
+
+/* First index equal to key (or -1) and the bounds, written out. */
+template <class T>
+static std::int64_t naive_find(const std::vector<T>& a, T key) {
+    for (std::size_t i = 0; i < a.size(); i++) {
+        if (a[i] == key) return (std::int64_t)i;
+        if (key < a[i]) break;
+    }
+    return -1;
+}
+
+template <class T>
+static std::int64_t naive_lower(const std::vector<T>& a, T key) {
+    std::size_t i = 0;
+    while (i < a.size() && a[i] < key) i++;
+    return (std::int64_t)i;
+}
+
+template <class T>
+static std::int64_t naive_upper(const std::vector<T>& a, T key) {
+    std::size_t i = 0;
+    while (i < a.size() && !(key < a[i])) i++;
+    return (std::int64_t)i;
+}
+
+/* Sorted keys with gaps and runs of duplicates; probes are every key and its
+ * neighbours. Sizes cross the prefetch threshold and the block edges. */
+template <class T>
+static void check_type(T step) {
+    static const std::size_t sizes[] = {0, 1, 2, 15, 16, 17, 100, 1000, 40000};
+    for (std::size_t size : sizes) {
+        std::vector<T> a(size);
+        T v = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            if (i % 3 != 0) v = (T)(v + step);
+            a[i] = v;
+        }
+        std::vector<T> probes;
+        for (std::size_t i = 0; i < size; i += 1 + size / 2000) {
+            probes.push_back(a[i]);
+            probes.push_back((T)(a[i] + 1));
+        }
+        probes.push_back((T)(v + step));
+
+        speedup::sorted_view<T> view(a.data(), a.size());
+        speedup::index<T, speedup::layout::sorted> sorted(view);
+        speedup::index<T, speedup::layout::eytzinger> eytzinger(a.data(), a.size());
+        speedup::index<T, speedup::layout::stree> stree(a.data(), a.size());
+        assert(view.size() == size && sorted.size() == size && eytzinger.size() == size && stree.size() == size);
+
+        std::vector<std::int64_t> out(probes.size());
+        for (std::size_t p = 0; p < probes.size(); p++) {
+            T key = probes[p];
+            std::int64_t want = naive_find(a, key);
+            std::int64_t lower = naive_lower(a, key);
+            assert(view.find(key) == want);
+            assert(view.lower_bound(key) == lower);
+            assert(view.upper_bound(key) == naive_upper(a, key));
+            assert(view.contains(key) == (want >= 0));
+            assert(sorted.find(key) == want && sorted.lower_bound(key) == lower);
+            assert(eytzinger.find(key) == want && eytzinger.lower_bound(key) == lower);
+            assert(stree.find(key) == want && stree.lower_bound(key) == lower);
+        }
+
+        view.find_batch(probes.data(), probes.size(), out.data());
+        for (std::size_t p = 0; p < probes.size(); p++) assert(out[p] == naive_find(a, probes[p]));
+        eytzinger.find_batch(probes.data(), probes.size(), out.data());
+        for (std::size_t p = 0; p < probes.size(); p++) assert(out[p] == naive_find(a, probes[p]));
+        stree.find_batch(probes.data(), probes.size(), out.data());
+        for (std::size_t p = 0; p < probes.size(); p++) assert(out[p] == naive_find(a, probes[p]));
+        sorted.find_batch(probes.data(), probes.size(), out.data());
+        for (std::size_t p = 0; p < probes.size(); p++) assert(out[p] == naive_find(a, probes[p]));
+#if defined(SPEEDUP_HAS_SPAN)
+        stree.find_batch(std::span<const T>(probes), std::span<std::int64_t>(out));
+        for (std::size_t p = 0; p < probes.size(); p++) assert(out[p] == naive_find(a, probes[p]));
+        speedup::sorted_view<T> span_view{std::span<const T>(a)};
+        assert(span_view.size() == size);
+#endif
+    }
+}
+
+/* Floating-point keys: +inf as data and as a probe, and probes outside the
+ * key range, against every layout. */
+template <class T>
+static void check_infinity() {
+    const T inf = std::numeric_limits<T>::infinity();
+    for (std::size_t size : {std::size_t(1), std::size_t(100), std::size_t(101), std::size_t(5000)}) {
+        for (int with_inf = 0; with_inf < 2; with_inf++) {
+            std::vector<T> a(size);
+            for (std::size_t i = 0; i < size; i++) a[i] = (T)i * (T)0.5;
+            if (with_inf) a[size - 1] = inf;
+
+            speedup::sorted_view<T> view(a.data(), a.size());
+            speedup::index<T, speedup::layout::sorted> sorted(view);
+            speedup::index<T, speedup::layout::eytzinger> eytzinger(view);
+            speedup::index<T, speedup::layout::stree> stree(view);
+            const T probes[] = {inf, -inf, std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(), (T)-1,
+                                (T)size, a[size - 1]};
+            std::vector<std::int64_t> out(sizeof(probes) / sizeof(probes[0]));
+            for (T key : probes) {
+                std::int64_t want = naive_find(a, key);
+                std::int64_t lower = naive_lower(a, key);
+                assert(view.find(key) == want && view.lower_bound(key) == lower);
+                assert(sorted.find(key) == want && sorted.lower_bound(key) == lower);
+                assert(eytzinger.find(key) == want && eytzinger.lower_bound(key) == lower);
+                assert(stree.find(key) == want && stree.lower_bound(key) == lower);
+            }
+            stree.find_batch(probes, out.size(), out.data());
+            for (std::size_t p = 0; p < out.size(); p++) assert(out[p] == naive_find(a, probes[p]));
+        }
+    }
+}
+
+int main() {
+    speedup_init();
+    check_type<std::int64_t>(7);
+    check_type<std::int32_t>(3);
+    check_type<std::uint16_t>(1);
+    check_type<double>(0.5);
+    check_infinity<float>();
+    check_infinity<double>();
+
+    /* int64_t runs the C library's kernels: same answers as the C entry
+     * points, duplicates included. */
+    std::vector<std::int64_t> a(5000);
+    for (std::size_t i = 0; i < a.size(); i++) a[i] = (std::int64_t)(i / 4) * 3;
+    speedup::sorted_view<std::int64_t> view(a.data(), a.size());
+    for (std::int64_t key = -2; key < 3800; key++) {
+        assert(view.find(key) == speedup_binary_search_i64_branchless(a.data(), key, (std::int64_t)a.size()));
+        assert(view.lower_bound(key) == speedup_lower_bound_i64(a.data(), key, (std::int64_t)a.size()));
+    }
+
+    /* Indexes move, and an empty one finds nothing. */
+    speedup::index<std::int64_t> moved(a.data(), a.size());
+    speedup::index<std::int64_t> target = std::move(moved);
+    assert(target.find(3) == 4 && target.memory_bytes() >= a.size() * 16);
+    speedup::index<std::int64_t, speedup::layout::stree> empty;
+    assert(empty.empty() && empty.find(0) == -1 && empty.lower_bound(0) == 0);
+    return 0;
+}
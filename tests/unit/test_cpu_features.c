@@ -0,0 +1,32 @@
+#include <assert.h>
+#include <stdint.h>
+#include "speedup/api.h"
+
+int main(void) {
+    uint32_t line = speedup_cpu_cacheline_bytes();
+    assert(line >= 16 && line <= 512 && (line & (line - 1)) == 0);
+
+    int avx2 = speedup_cpu_has_avx2();
+    assert(avx2 == 0 || avx2 == 1);
+    assert(speedup_cpu_has_avx2() == avx2);
+#if !(defined(__x86_64__) || defined(_M_X64))
+    assert(!avx2 && !speedup_cpu_has_avx512() && !speedup_cpu_has_bmi2());
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+    assert(speedup_cpu_has_neon());
+#endif
+
+    speedup_init();
+    assert(speedup_get_cache_hint().cacheline_bytes == line);
+
+    /* Every preference change re-resolves the kernel table. */
+    int64_t a[5] = {2, 4, 6, 8, 10};
+    speedup_backend_pref_t prefs[] = {SPEEDUP_BACKEND_FORCE_CPU, SPEEDUP_BACKEND_AUTO, SPEEDUP_BACKEND_FORCE_CPU};
+    for (int i = 0; i < 3; i++) {
+        speedup_set_backend_preference(prefs[i]);
+        assert(speedup_get_backend_preference() == prefs[i]);
+        assert(speedup_binary_search_i64(a, 8, 5) == 3);
+        assert(speedup_binary_search_i64(a, 9, 5) == -1);
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "speedup/api.h"
+
+static void check_layout(speedup_index_layout_t layout, const int64_t* a, int64_t n) {
+    speedup_index_i64_t* index = speedup_index_i64_build(layout, a, n);
+    assert(index);
+    assert(speedup_index_i64_size(index) == n);
+    assert(speedup_index_i64_layout(index) == layout);
+    for (int64_t i = 0; i < n; i++) {
+        assert(speedup_index_i64_find(index, a[i]) == i);
+        assert(speedup_index_i64_find(index, a[i] + 1) == -1);
+    }
+    assert(speedup_index_i64_find(index, -1) == -1);
+    assert(speedup_index_i64_find(index, INT64_MAX) == -1);
+    speedup_index_i64_free(index);
+}
+
+/* Every key of r finds its first occurrence; keys in gaps miss. */
+static void check_index(speedup_index_i64_t* index, const int64_t* r, int64_t n) {
+    assert(index);
+    for (int64_t i = 0; i < n; i++) {
+        int64_t first = i;
+        while (first > 0 && r[first - 1] == r[i]) first--;
+        assert(speedup_index_i64_find(index, r[i]) == first);
+        if (i + 1 < n && r[i + 1] > r[i] + 1) assert(speedup_index_i64_find(index, r[i] + 1) == -1);
+    }
+    speedup_index_i64_free(index);
+}
+
+int main(void) {
+    int64_t sizes[] = {0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 33, 100, 1000, 4097};
+    int64_t* a = (int64_t*)malloc(4097 * sizeof(int64_t));
+    for (int64_t i = 0; i < 4097; i++) a[i] = i * 2;
+
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        for (int layout = 1; speedup_index_layout_name((speedup_index_layout_t)layout); layout++) {
+            check_layout((speedup_index_layout_t)layout, a, sizes[s]);
+        }
+    }
+
+    int64_t dup[6] = {1, 3, 3, 3, 5, 5};
+    for (int layout = 1; speedup_index_layout_name((speedup_index_layout_t)layout); layout++) {
+        speedup_index_i64_t* index = speedup_index_i64_build((speedup_index_layout_t)layout, dup, 6);
+        assert(speedup_index_i64_find(index, 3) == 1);
+        assert(speedup_index_i64_find(index, 5) == 4);
+        assert(speedup_index_i64_memory_bytes(index) >= 6 * (int64_t)sizeof(int64_t));
+        speedup_index_i64_free(index);
+    }
+
+    /* Irregular keys: random gaps, runs of duplicates, both int64 extremes. */
+    int64_t n = 100000;
+    int64_t* r = (int64_t*)malloc(n * sizeof(int64_t));
+    uint64_t x = 88172645463325252ULL;
+    r[0] = INT64_MIN;
+    for (int64_t i = 1; i < n - 1; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        int64_t gap = (x % 8 == 0) ? 0 : (int64_t)(x % ((i % 5000 < 100) ? 1000000 : 50));
+        r[i] = (i == 1 ? -((int64_t)1 << 40) : r[i - 1]) + gap;
+    }
+    r[n - 1] = INT64_MAX;
+
+    /* Learned index for several error bounds. */
+    int64_t eps[] = {0, 1, 8, 256};
+    for (int e = 0; e < 4; e++) check_index(speedup_index_i64_build_pgm(r, n, eps[e]), r, n);
+
+    /* Compressed layout, whose deltas here range from 0 to 64 bits per block. */
+    check_index(speedup_index_i64_build(SPEEDUP_INDEX_LAYOUT_FOR, r, n), r, n);
+
+    /* Summaries with a tiny budget (k = 128) and with the default one. */
+    check_index(speedup_index_i64_build_summary(r, n, 8000), r, n);
+    check_index(speedup_index_i64_build_summary(r, n, 0), r, n);
+    /* The default follows the cache hint: an L2-sized summary while blocks
+     * stay at 16 keys or fewer, else 16-key blocks and an L3-sized summary. */
+    speedup_cache_hint_t saved = speedup_get_cache_hint();
+    speedup_cache_hint_t hint = saved;
+    int64_t hint_bytes[][3] = {
+        {1 << 20, 8 << 20, 8},      /* n / 8 keys fit L2 */
+        {1 << 16, 8 << 20, 16},     /* n / 16 fit L2 */
+        {1 << 14, 8 << 20, 16},     /* L2 would need k = 64: L3 with k = 16 */
+        {1 << 14, 1 << 14, 64},     /* n / 64 keys fit L3 */
+    };
+    for (int h = 0; h < 4; h++) {
+        hint.l2_bytes = (uint32_t)hint_bytes[h][0];
+        hint.l3_bytes = (uint32_t)hint_bytes[h][1];
+        speedup_set_cache_hint(hint);
+        speedup_index_i64_t* summary = speedup_index_i64_build(SPEEDUP_INDEX_LAYOUT_SUMMARY, r, n);
+        int64_t summary_bytes = (n + hint_bytes[h][2] - 1) / hint_bytes[h][2] * (int64_t)sizeof(int64_t);
+        int64_t model = speedup_index_i64_model_bytes(summary);  /* also counts the index header */
+        assert(model >= summary_bytes && model < summary_bytes + 2048);
+        (void)model;
+        (void)summary_bytes;
+        check_index(summary, r, n);
+    }
+    speedup_set_cache_hint(saved);
+    /* Budgets below one key still build a working (single-sample) summary. */
+    for (int64_t cb = 1; cb < 8; cb++) check_index(speedup_index_i64_build_summary(r, 1000, cb), r, 1000);
+
+    assert(speedup_index_i64_build_pgm(r, n, -1) == NULL);
+    assert(speedup_index_i64_build_summary(r, n, -1) == NULL);
+    free(r);
+
+    /* Uniform keys fit in a handful of segments. */
+    speedup_index_i64_t* pgm = speedup_index_i64_build_pgm(a, 4097, 0);
+    assert(speedup_index_i64_model_bytes(pgm) < 4097);
+    speedup_index_i64_free(pgm);
+
+    /* Dense keys compress to about a byte each; duplicate runs longer than
+     * a block still return their first position. */
+    speedup_index_i64_t* packed = speedup_index_i64_build(SPEEDUP_INDEX_LAYOUT_FOR, a, 4097);
+    assert(speedup_index_i64_memory_bytes(packed) < 2 * 4097 + 1024);
+    assert(speedup_index_i64_model_bytes(packed) < 0);
+    speedup_index_i64_free(packed);
+    for (int64_t i = 0; i < 4097; i++) a[i] = i / 300 * 7;
+    packed = speedup_index_i64_build(SPEEDUP_INDEX_LAYOUT_FOR, a, 4097);
+    for (int64_t i = 0; i < 4097; i++) {
+        assert(speedup_index_i64_find(packed, a[i]) == i / 300 * 300);
+        assert(speedup_index_i64_find(packed, a[i] + 1) == -1);
+    }
+    speedup_index_i64_free(packed);
+
+    free(a);
+    return 0;
+}
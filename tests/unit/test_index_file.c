@@ -0,0 +1,154 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "speedup/api.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef HANDLE test_thread_t;
+#define THREAD_FN(name) static DWORD WINAPI name(LPVOID arg)
+#define THREAD_RETURN return 0
+static void thread_start(test_thread_t* t, LPTHREAD_START_ROUTINE fn, void* arg) {
+    *t = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    assert(*t != NULL);
+}
+static void thread_join(test_thread_t t) {
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+#else
+#include <pthread.h>
+typedef pthread_t test_thread_t;
+#define THREAD_FN(name) static void* name(void* arg)
+#define THREAD_RETURN return NULL
+static void thread_start(test_thread_t* t, void* (*fn)(void*), void* arg) {
+    int rc = pthread_create(t, NULL, fn, arg);
+    assert(rc == 0);
+    (void)rc;
+}
+static void thread_join(test_thread_t t) { pthread_join(t, NULL); }
+#endif
+
+#define PATH "speedup_test_index_file.idx"
+#define SAVERS 4
+#define SAVES 10
+
+static void flip_byte(long offset) {
+    FILE* f = fopen(PATH, "r+b");
+    assert(f);
+    fseek(f, offset, SEEK_SET);
+    int c = fgetc(f);
+    fseek(f, offset, SEEK_SET);
+    fputc(c ^ 0x40, f);
+    fclose(f);
+}
+
+/* The opened index must answer exactly like the built one. */
+static void check_round_trip(speedup_index_i64_t* built, const int64_t* a, int64_t n) {
+    int rc = speedup_index_i64_save(built, PATH);
+    assert(rc == 0);
+    (void)rc;
+    speedup_index_open_flags_t flags[] = {SPEEDUP_INDEX_OPEN_DEFAULT, SPEEDUP_INDEX_OPEN_VERIFY};
+    for (int f = 0; f < 2; f++) {
+        speedup_index_i64_t* opened = speedup_index_i64_open(PATH, flags[f]);
+        assert(opened);
+        assert(speedup_index_i64_layout(opened) == speedup_index_i64_layout(built));
+        assert(speedup_index_i64_size(opened) == n);
+        assert(speedup_index_i64_memory_bytes(opened) == speedup_index_i64_memory_bytes(built));
+        assert(speedup_index_i64_verify(opened) == 0);
+        for (int64_t i = 0; i < n; i++) {
+            assert(speedup_index_i64_find(opened, a[i]) == speedup_index_i64_find(built, a[i]));
+            assert(speedup_index_i64_find(opened, a[i] + 1) == speedup_index_i64_find(built, a[i] + 1));
+        }
+        assert(speedup_index_i64_find(opened, INT64_MIN) == speedup_index_i64_find(built, INT64_MIN));
+        speedup_index_i64_free(opened);
+    }
+}
+
+THREAD_FN(saver) {
+    const speedup_index_i64_t* index = (const speedup_index_i64_t*)arg;
+    for (int i = 0; i < SAVES; i++) {
+        int rc = speedup_index_i64_save(index, PATH);
+        assert(rc == 0);
+        (void)rc;
+    }
+    THREAD_RETURN;
+}
+
+/* Concurrent saves of one path each write their own temp file, so whichever
+ * lands last is a complete, valid index. */
+static void check_concurrent_saves(const int64_t* a) {
+    speedup_index_i64_t* built[SAVERS];
+    test_thread_t threads[SAVERS];
+    for (int t = 0; t < SAVERS; t++) {
+        built[t] = speedup_index_i64_build(SPEEDUP_INDEX_LAYOUT_EYTZINGER, a, 1000 + 7000 * t);
+        thread_start(&threads[t], saver, built[t]);
+    }
+    for (int t = 0; t < SAVERS; t++) thread_join(threads[t]);
+    speedup_index_i64_t* opened = speedup_index_i64_open(PATH, SPEEDUP_INDEX_OPEN_VERIFY);
+    assert(opened);
+    speedup_index_i64_free(opened);
+    for (int t = 0; t < SAVERS; t++) speedup_index_i64_free(built[t]);
+}
+
+int main(void) {
+    int64_t sizes[] = {0, 1, 17, 1000, 50000};
+    int64_t* a = (int64_t*)malloc(50000 * sizeof(int64_t));
+
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        int64_t n = sizes[s];
+        for (int64_t i = 0; i < n; i++) a[i] = i / 3 * 5 - 1000;  /* duplicate runs */
+        for (int layout = 1; speedup_index_layout_name((speedup_index_layout_t)layout); layout++) {
+            speedup_index_i64_t* built = speedup_index_i64_build((speedup_index_layout_t)layout, a, n);
+            assert(built);
+            assert(speedup_index_i64_verify(built) == 0);
+            check_round_trip(built, a, n);
+            speedup_index_i64_free(built);
+        }
+    }
+
+    speedup_index_i64_t* built = speedup_index_i64_build_pgm(a, 50000, 16);
+    check_round_trip(built, a, 50000);
+
+    /* A damaged key section opens (only the header is read) but fails
+     * verification; a damaged header or a truncated file does not open. */
+    flip_byte(4096 + 8 * 123);
+    speedup_index_i64_t* opened = speedup_index_i64_open(PATH, SPEEDUP_INDEX_OPEN_DEFAULT);
+    assert(opened);
+    assert(speedup_index_i64_verify(opened) == -1);
+    speedup_index_i64_free(opened);
+    assert(speedup_index_i64_open(PATH, SPEEDUP_INDEX_OPEN_VERIFY) == NULL);
+
+    int rc = speedup_index_i64_save(built, PATH);
+    assert(rc == 0);
+    flip_byte(40);
+    assert(speedup_index_i64_open(PATH, SPEEDUP_INDEX_OPEN_DEFAULT) == NULL);
+
+    rc = speedup_index_i64_save(built, PATH);
+    assert(rc == 0);
+    (void)rc;
+    FILE* f = fopen(PATH, "rb");
+    assert(f);
+    char* head = (char*)malloc(8192);
+    size_t got = fread(head, 1, 8192, f);
+    assert(got == 8192);
+    (void)got;
+    fclose(f);
+    f = fopen(PATH, "wb");
+    fwrite(head, 1, 8192, f);
+    fclose(f);
+    assert(speedup_index_i64_open(PATH, SPEEDUP_INDEX_OPEN_DEFAULT) == NULL);
+
+    assert(speedup_index_i64_open("speedup_test_missing.idx", SPEEDUP_INDEX_OPEN_DEFAULT) == NULL);
+    assert(speedup_index_i64_save(NULL, PATH) == -1);
+    assert(speedup_index_i64_save(built, "speedup_test_missing_dir/index.idx") == -1);
+
+    check_concurrent_saves(a);
+
+    remove(PATH);
+    free(head);
+    speedup_index_i64_free(built);
+    free(a);
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "speedup/api.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef HANDLE test_thread_t;
+#define THREAD_FN(name) static DWORD WINAPI name(LPVOID arg)
+#define THREAD_RETURN return 0
+static void thread_start(test_thread_t* t, LPTHREAD_START_ROUTINE fn, void* arg) {
+    *t = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    assert(*t != NULL);
+}
+static void thread_join(test_thread_t t) {
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+static void sleep_ms(int ms) { Sleep((DWORD)ms); }
+#else
+#include <pthread.h>
+#include <time.h>
+typedef pthread_t test_thread_t;
+#define THREAD_FN(name) static void* name(void* arg)
+#define THREAD_RETURN return NULL
+static void thread_start(test_thread_t* t, void* (*fn)(void*), void* arg) {
+    int rc = pthread_create(t, NULL, fn, arg);
+    assert(rc == 0);
+    (void)rc;
+}
+static void thread_join(test_thread_t t) { pthread_join(t, NULL); }
+static void sleep_ms(int ms) {
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+}
+#endif
+
+#define VERSIONS 200
+#define READERS 3
+
+/* Version v holds the keys 0, 2, ..., 2 * (100 + v - 1). */
+static speedup_index_i64_t* build_version(int v) {
+    int64_t n = 100 + v;
+    int64_t* keys = (int64_t*)malloc((size_t)n * sizeof(int64_t));
+    for (int64_t i = 0; i < n; i++) keys[i] = 2 * i;
+    speedup_index_layout_t layout = v % 2 ? SPEEDUP_INDEX_LAYOUT_EYTZINGER : SPEEDUP_INDEX_LAYOUT_STREE;
+    speedup_index_i64_t* index = speedup_index_i64_build(layout, keys, n);
+    free(keys);
+    assert(index);
+    return index;
+}
+
+typedef struct shared_t {
+    speedup_index_handle_t* handle;
+    atomic_int stop;
+    atomic_int published;
+} shared_t;
+
+THREAD_FN(publisher) {
+    shared_t* s = (shared_t*)arg;
+    speedup_index_handle_publish(s->handle, build_version(2));
+    atomic_store(&s->published, 1);
+    THREAD_RETURN;
+}
+
+/* Each section sees one whole version: every key it holds is found at its
+ * rank, the next one is missing, and versions never go backwards. */
+THREAD_FN(reader) {
+    shared_t* s = (shared_t*)arg;
+    int64_t last = 0;
+    uint64_t rng = (uint64_t)(uintptr_t)&last;
+    while (!atomic_load(&s->stop)) {
+        speedup_index_guard_t guard;
+        const speedup_index_i64_t* index = speedup_index_handle_acquire(s->handle, &guard);
+        int64_t n = speedup_index_i64_size(index);
+        assert(n >= last);
+        last = n;
+        for (int k = 0; k < 16; k++) {
+            rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+            int64_t i = (int64_t)((rng >> 33) % (uint64_t)n);
+            assert(speedup_index_i64_find(index, 2 * i) == i);
+        }
+        assert(speedup_index_i64_find(index, 2 * n) == -1);
+        speedup_index_handle_release(s->handle, &guard);
+        assert(speedup_index_handle_find(s->handle, 1) == -1);
+    }
+    THREAD_RETURN;
+}
+
+int main(void) {
+    /* Empty handle, then a first version; sections nest. */
+    speedup_index_handle_t* handle = speedup_index_handle_create(NULL);
+    assert(handle);
+    assert(speedup_index_handle_find(handle, 0) == -1);
+    assert(speedup_index_handle_version(handle) == 1);
+    speedup_index_handle_publish(handle, build_version(1));
+    assert(speedup_index_handle_version(handle) == 2);
+    assert(speedup_index_handle_find(handle, 200) == 100);
+    speedup_index_guard_t outer, inner;
+    const speedup_index_i64_t* a = speedup_index_handle_acquire(handle, &outer);
+    const speedup_index_i64_t* b = speedup_index_handle_acquire(handle, &inner);
+    assert(a == b);
+    speedup_index_handle_release(handle, &inner);
+    speedup_index_handle_release(handle, &outer);
+
+    /* A publish waits for a reader holding the old version, while new
+     * sections already see the new one. */
+    shared_t s;
+    s.handle = handle;
+    atomic_init(&s.stop, 0);
+    atomic_init(&s.published, 0);
+    const speedup_index_i64_t* held = speedup_index_handle_acquire(handle, &outer);
+    test_thread_t writer;
+    thread_start(&writer, publisher, &s);
+    while (speedup_index_handle_version(handle) < 3) sleep_ms(1);
+    sleep_ms(50);
+    assert(!atomic_load(&s.published));
+    assert(speedup_index_handle_find(handle, 202) == 101);
+    assert(speedup_index_i64_find(held, 200) == 100 && speedup_index_i64_find(held, 202) == -1);
+    speedup_index_handle_release(handle, &outer);
+    thread_join(writer);
+    assert(atomic_load(&s.published));
+
+    /* Readers run while versions are published and reclaimed. */
+    test_thread_t readers[READERS];
+    for (int r = 0; r < READERS; r++) thread_start(&readers[r], reader, &s);
+    for (int v = 3; v < VERSIONS; v++) {
+        speedup_index_handle_publish(handle, build_version(v));
+        if (v % 50 == 0) sleep_ms(1);
+    }
+    atomic_store(&s.stop, 1);
+    for (int r = 0; r < READERS; r++) thread_join(readers[r]);
+    assert(speedup_index_handle_version(handle) == VERSIONS);
+    assert(speedup_index_handle_find(handle, 2 * (100 + VERSIONS - 2)) == 100 + VERSIONS - 2);
+
+    speedup_index_handle_free(handle);
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "speedup/api.h"
+
+#define N 20000
+
+static int64_t first_match(const int64_t* a, int64_t size, int64_t key) {
+    int64_t pos = speedup_lower_bound_i64_ref(a, key, size);
+    return (pos < size && a[pos] == key) ? pos : -1;
+}
+
+/* Every element, its neighbours and out-of-range keys, against the first
+ * match; the dispatched entry point may return any equal element. */
+static void check(const int64_t* a, int64_t size) {
+    for (int64_t i = -1; i <= size; i++) {
+        int64_t base = i < 0 ? a[0] - 5 : i == size ? a[size - 1] + 5 : a[i];
+        for (int64_t key = base - 1; key <= base + 1; key++) {
+            int64_t expected = first_match(a, size, key);
+            assert(speedup_binary_search_i64_interpolation(a, key, size) == expected);
+            int64_t got = speedup_binary_search_i64(a, key, size);
+            assert(expected < 0 ? got == -1 : (got >= 0 && a[got] == key));
+        }
+    }
+}
+
+int main(void) {
+    int64_t* a = (int64_t*)malloc(N * sizeof(int64_t));
+    int64_t sizes[] = {1, 2, 3, 100, 4096, N};
+
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        int64_t size = sizes[s];
+
+        for (int64_t i = 0; i < size; i++) a[i] = i * 2;          /* uniform */
+        check(a, size);
+        for (int64_t i = 0; i < size; i++) a[i] = i * i;          /* skewed */
+        check(a, size);
+        for (int64_t i = 0; i < size; i++) a[i] = i / 7 * 3;      /* duplicate runs */
+        check(a, size);
+        for (int64_t i = 0; i < size; i++) {                     /* one far outlier */
+            a[i] = i + 1 < size ? i : (int64_t)1 << 60;
+        }
+        check(a, size);
+        for (int64_t i = 0; i < size; i++) a[i] = 7;              /* constant */
+        check(a, size);
+    }
+
+    /* The sampled check accepts evenly spaced keys and rejects skew and a
+     * far outlier; either way the kernel stays correct. */
+    for (int64_t i = 0; i < N; i++) a[i] = i * 3;
+    assert(speedup_keys_uniform_i64(a, N) == 1);
+    check(a, N);
+    for (int64_t i = 0; i < N; i++) a[i] = i * i;
+    assert(speedup_keys_uniform_i64(a, N) == 0);
+    a[N - 1] = (int64_t)1 << 60;
+    assert(speedup_keys_uniform_i64(a, N) == 0);
+    assert(speedup_keys_uniform_i64(a, 1) == 0);
+
+    /* Unsorted batches take the interpolation path on uniform arrays and the
+     * interleaved one on skewed arrays; both return first matches. */
+    int64_t* keys = (int64_t*)malloc(N * sizeof(int64_t));
+    int64_t* out = (int64_t*)malloc(N * sizeof(int64_t));
+    for (int shape = 0; shape < 3; shape++) {
+        for (int64_t i = 0; i < N; i++) a[i] = shape == 0 ? i * 2 : shape == 1 ? i * i : i / 7 * 3;
+        uint64_t x = 88172645463325252ULL;
+        for (int64_t i = 0; i < N; i++) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            keys[i] = (int64_t)(x % (uint64_t)(a[N - 1] + 3)) - 1;
+        }
+        speedup_binary_search_i64_batch(a, N, keys, N, out);
+        for (int64_t i = 0; i < N; i++) assert(out[i] == first_match(a, N, keys[i]));
+        speedup_binary_search_i64_batch_interpolation(a, N, keys, 100, out);
+        for (int64_t i = 0; i < 100; i++) assert(out[i] == first_match(a, N, keys[i]));
+    }
+    speedup_binary_search_i64_batch_interpolation(a, 0, keys, 5, out);
+    for (int64_t i = 0; i < 5; i++) assert(out[i] == -1);
+    free(keys);
+    free(out);
+
+    /* A profile can route the dispatcher to the kernel; calibration never
+     * picks it. */
+    const char* path = "speedup_test_interpolation.profile";
+    FILE* f = fopen(path, "w");
+    fprintf(f, "speedup-tuning 1\n4096 branchless\nmax interpolation\n");
+    fclose(f);
+    int rc = speedup_tuning_load(path);
+    assert(rc == 0);
+    (void)rc;
+    assert(strcmp(speedup_tuning_kernel_for_size(N), "interpolation") == 0);
+    for (int64_t i = 0; i < N; i++) a[i] = i * 2;
+    check(a, N);
+    for (int64_t i = 0; i < N; i++) a[i] = i * i;
+    check(a, N);
+    rc = speedup_calibrate(1 << 16);
+    assert(rc == 0);
+    assert(strcmp(speedup_tuning_kernel_for_size(1 << 16), "interpolation") != 0);
+    speedup_tuning_reset();
+    remove(path);
+
+    free(a);
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "speedup/api.h"
+
+typedef int64_t (*count_fn)(const int64_t* a, int64_t a_size, const int64_t* b, int64_t b_size);
+
+/* std::set_intersection, written out: equal elements pair up in order. */
+static int64_t naive(const int64_t* a, int64_t na, const int64_t* b, int64_t nb, int64_t* values, int64_t* ap, int64_t* bp) {
+    int64_t i = 0, j = 0, n = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            values[n] = a[i];
+            ap[n] = i++;
+            bp[n] = j++;
+            n++;
+        }
+    }
+    return n;
+}
+
+/* Sorted values with runs of duplicates; step sets the spread. */
+static void fill(int64_t* a, int64_t size, int64_t step, uint64_t* rng) {
+    int64_t v = INT64_MIN / 2;
+    for (int64_t i = 0; i < size; i++) {
+        *rng = *rng * 6364136223846793005ULL + 1442695040888963407ULL;
+        if ((*rng >> 60) != 0) v += 1 + (int64_t)((*rng >> 33) % (uint64_t)step);
+        a[i] = v;
+    }
+}
+
+int main(void) {
+    count_fn count[] = {speedup_intersect_i64_count, speedup_intersect_i64_count_merge,
+                        speedup_intersect_i64_count_search};
+    int64_t sizes[][2] = {{0, 0}, {0, 5}, {5, 0}, {1, 1}, {3, 7}, {4, 4}, {17, 19}, {100, 100},
+                          {1000, 997}, {10, 1000}, {1000, 10}, {3, 5000}, {5000, 1}, {4096, 40}};
+    int64_t steps[][2] = {{1, 1}, {2, 3}, {1, 50}, {40, 1}};
+    int64_t* a = (int64_t*)malloc(5000 * sizeof(int64_t));
+    int64_t* b = (int64_t*)malloc(5000 * sizeof(int64_t));
+    int64_t* want[3];
+    int64_t* got[3];
+    for (int k = 0; k < 3; k++) {
+        want[k] = (int64_t*)malloc(5000 * sizeof(int64_t));
+        got[k] = (int64_t*)malloc(5000 * sizeof(int64_t));
+    }
+
+    uint64_t rng = 42;
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        for (int t = 0; t < (int)(sizeof(steps) / sizeof(steps[0])); t++) {
+            int64_t na = sizes[s][0], nb = sizes[s][1];
+            fill(a, na, steps[t][0], &rng);
+            fill(b, nb, steps[t][1], &rng);
+            int64_t n = naive(a, na, b, nb, want[0], want[1], want[2]);
+
+            for (int k = 0; k < 3; k++) assert(count[k](a, na, b, nb) == n);
+            assert(speedup_intersect_i64(a, na, b, nb, got[0]) == n);
+            assert(speedup_intersect_i64_positions(a, na, b, nb, got[1], got[2]) == n);
+            for (int64_t i = 0; i < n; i++) {
+                assert(got[0][i] == want[0][i]);
+                assert(got[1][i] == want[1][i]);
+                assert(got[2][i] == want[2][i]);
+            }
+            assert(speedup_intersect_i64_positions(a, na, b, nb, NULL, got[2]) == n);
+            assert(speedup_intersect_i64_count(b, nb, a, na) == n);
+        }
+    }
+
+    /* Identical arrays and the int64 extremes. */
+    for (int64_t i = 0; i < 1000; i++) a[i] = i;
+    a[0] = INT64_MIN;
+    a[999] = INT64_MAX;
+    for (int k = 0; k < 3; k++) assert(count[k](a, 1000, a, 1000) == 1000);
+    b[0] = INT64_MIN;
+    b[1] = INT64_MAX;
+    for (int k = 0; k < 3; k++) assert(count[k](a, 1000, b, 2) == 2);
+
+    free(a);
+    free(b);
+    for (int k = 0; k < 3; k++) {
+        free(want[k]);
+        free(got[k]);
+    }
+    return 0;
+}
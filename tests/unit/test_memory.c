@@ -0,0 +1,48 @@
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include "speedup/api.h"
+
+static void check_block(size_t bytes) {
+    unsigned char* p = (unsigned char*)speedup_alloc(bytes);
+    assert(p != NULL);
+    assert(((uintptr_t)p & 127) == 0);
+    if (bytes) {
+        memset(p, 0xA5, bytes);
+        assert(p[0] == 0xA5 && p[bytes - 1] == 0xA5);
+    }
+    size_t page = speedup_alloc_page_size(p);
+    assert(page == 0 || page == ((size_t)2 << 20) || page == ((size_t)1 << 30));
+    /* Huge-page blocks start on their page boundary, header included. */
+    if (page) assert(((uintptr_t)p & (page - 1)) == 0);
+    /* Huge pages are only attempted for large blocks under AUTO. */
+    if (bytes < ((size_t)1 << 20) || speedup_get_page_policy() == SPEEDUP_PAGES_SMALL) assert(page == 0);
+    speedup_free(p);
+}
+
+int main(void) {
+    size_t sizes[] = {0, 1, 100, 4096, (size_t)2 << 20, ((size_t)4 << 20) + 12345};
+
+    speedup_free(NULL);
+    assert(speedup_alloc_page_size(NULL) == 0);
+    assert(speedup_get_page_policy() == SPEEDUP_PAGES_AUTO);
+
+    speedup_page_policy_t policies[] = {SPEEDUP_PAGES_AUTO, SPEEDUP_PAGES_SMALL};
+    for (int p = 0; p < 2; p++) {
+        speedup_set_page_policy(policies[p]);
+        assert(speedup_get_page_policy() == policies[p]);
+        for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) check_block(sizes[s]);
+
+        /* Indexes are built from the same allocator under either policy. */
+        const int64_t n = 600000;
+        int64_t* a = (int64_t*)speedup_alloc((size_t)n * sizeof(int64_t));
+        assert(a != NULL);
+        for (int64_t i = 0; i < n; i++) a[i] = i * 3;
+        speedup_index_i64_t* index = speedup_index_i64_build(SPEEDUP_INDEX_LAYOUT_EYTZINGER, a, n);
+        assert(index != NULL);
+        for (int64_t i = 0; i < n; i += 997) assert(speedup_index_i64_find(index, a[i]) == i);
+        speedup_index_i64_free(index);
+        speedup_free(a);
+    }
+    return 0;
+}
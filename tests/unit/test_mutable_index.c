@@ -0,0 +1,84 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "speedup/api.h"
+
+#define DOMAIN 40000
+
+static uint64_t next_random(uint64_t* state) {
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state >> 33;
+}
+
+static void check_all(const speedup_mutable_i64_t* set, const unsigned char* present, int64_t count) {
+    assert(speedup_mutable_i64_size(set) == count);
+    for (int64_t key = -1; key <= DOMAIN; key++) {
+        int want = key >= 0 && key < DOMAIN && present[key];
+        assert(speedup_mutable_i64_contains(set, key) == want);
+    }
+}
+
+int main(void) {
+    int64_t unsorted[] = {3, 1, 2};
+    assert(speedup_mutable_i64_create(unsorted, 3) == NULL);
+
+    /* Duplicates collapse; an empty set works. */
+    int64_t dups[] = {1, 1, 2, 2, 2, 5};
+    speedup_mutable_i64_t* small = speedup_mutable_i64_create(dups, 6);
+    assert(small && speedup_mutable_i64_size(small) == 3);
+    assert(speedup_mutable_i64_erase(small, 2) == 1);
+    assert(speedup_mutable_i64_erase(small, 2) == 0);
+    assert(speedup_mutable_i64_contains(small, 1) && !speedup_mutable_i64_contains(small, 2));
+    speedup_mutable_i64_free(small);
+    small = speedup_mutable_i64_create(NULL, 0);
+    assert(small && speedup_mutable_i64_size(small) == 0);
+    assert(speedup_mutable_i64_insert(small, INT64_MIN) == 1);
+    assert(speedup_mutable_i64_insert(small, INT64_MAX) == 1);
+    assert(speedup_mutable_i64_flush(small) == 0);
+    assert(speedup_mutable_i64_contains(small, INT64_MIN) && speedup_mutable_i64_contains(small, INT64_MAX));
+    assert(!speedup_mutable_i64_contains(small, 0));
+    speedup_mutable_i64_free(small);
+
+    /* Random inserts and erases against a reference bitmap, enough to run
+     * several merges, with a full check between rounds. */
+    unsigned char* present = (unsigned char*)calloc(DOMAIN, 1);
+    int64_t* initial = (int64_t*)malloc(DOMAIN * sizeof(int64_t));
+    int64_t count = 0;
+    for (int64_t key = 0; key < DOMAIN; key += 3) {
+        initial[count++] = key;
+        present[key] = 1;
+    }
+    speedup_mutable_i64_t* set = speedup_mutable_i64_create(initial, count);
+    assert(set);
+    check_all(set, present, count);
+
+    uint64_t rng = 7;
+    int64_t ops_per_round = speedup_mutable_i64_buffer_capacity(set) / 3 + 17;
+    for (int round = 0; round < 12; round++) {
+        for (int64_t op = 0; op < ops_per_round; op++) {
+            int64_t key = (int64_t)(next_random(&rng) % DOMAIN);
+            /* Inserts outnumber erases early on and the reverse later. */
+            if ((int64_t)(next_random(&rng) % 12) >= round) {
+                assert(speedup_mutable_i64_insert(set, key) == !present[key]);
+                count += !present[key];
+                present[key] = 1;
+            } else {
+                assert(speedup_mutable_i64_erase(set, key) == present[key]);
+                count -= present[key];
+                present[key] = 0;
+            }
+            if (op % 997 == 0) {
+                assert(speedup_mutable_i64_contains(set, key) == present[key]);
+            }
+        }
+        check_all(set, present, count);
+    }
+
+    assert(speedup_mutable_i64_flush(set) == 0);
+    check_all(set, present, count);
+
+    speedup_mutable_i64_free(set);
+    free(initial);
+    free(present);
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "speedup/api.h"
+
+static void check_index(const speedup_index_i64_t* index, const int64_t* a, int64_t n) {
+    for (int64_t i = 0; i < n; i += 7) {
+        assert(speedup_index_i64_find(index, a[i]) == i);
+        assert(speedup_index_i64_find(index, a[i] + 1) == -1);
+    }
+}
+
+int main(void) {
+    /* Detected topology: at least one node, current node always valid. */
+    int detected = speedup_numa_node_count();
+    assert(detected >= 1);
+    int node = speedup_numa_current_node();
+    assert(node >= 0 && node < detected);
+
+    assert(speedup_numa_set_topology("0-") == -1);
+    assert(speedup_numa_set_topology("0;x") == -1);
+    assert(speedup_numa_node_count() == detected);
+
+    const int64_t n = 20000;
+    int64_t* a = (int64_t*)malloc(n * sizeof(int64_t));
+    for (int64_t i = 0; i < n; i++) a[i] = i * 3;
+
+    /* Fake two-node topology on any machine: CPU 0 belongs to node 0 and
+     * node 1 is reached by binding. */
+    assert(speedup_numa_set_topology("0;0") == 0);
+    assert(speedup_numa_node_count() == 2);
+    assert(speedup_numa_bind_thread(2) == -1);
+    speedup_set_numa_replication(1);
+    assert(speedup_get_numa_replication() == 1);
+
+    for (int layout = 1; speedup_index_layout_name((speedup_index_layout_t)layout); layout++) {
+        speedup_set_numa_replication(0);
+        speedup_index_i64_t* single = speedup_index_i64_build((speedup_index_layout_t)layout, a, n);
+        speedup_set_numa_replication(1);
+        speedup_index_i64_t* index = speedup_index_i64_build((speedup_index_layout_t)layout, a, n);
+        assert(speedup_index_i64_replica_count(single) == 1);
+        assert(speedup_index_i64_replica_count(index) == 2);
+        assert(speedup_index_i64_memory_bytes(index) == 2 * speedup_index_i64_memory_bytes(single));
+        for (int k = 0; k < 2; k++) {
+            assert(speedup_numa_bind_thread(k) == 0);
+            assert(speedup_numa_current_node() == k);
+            check_index(index, a, n);
+        }
+        speedup_index_i64_free(single);
+        speedup_index_i64_free(index);
+    }
+
+    /* Pool workers are spread over the fake nodes; results are unchanged. */
+    int64_t* keys = (int64_t*)malloc(200000 * sizeof(int64_t));
+    int64_t* out = (int64_t*)malloc(200000 * sizeof(int64_t));
+    for (int64_t i = 0; i < 200000; i++) keys[i] = (i * 7919) % (3 * n);
+    speedup_set_threads_hint(4);
+    speedup_binary_search_i64_batch(a, n, keys, 200000, out);
+    for (int64_t i = 0; i < 200000; i++) assert(out[i] == speedup_binary_search_i64_ref(a, keys[i], n));
+
+    /* Back on the detected topology a single-node host keeps one copy. */
+    assert(speedup_numa_set_topology(NULL) == 0);
+    assert(speedup_numa_node_count() == detected);
+    speedup_index_i64_t* index = speedup_index_i64_build(SPEEDUP_INDEX_LAYOUT_STREE, a, n);
+    assert(speedup_index_i64_replica_count(index) == (detected > 1 ? detected : 1));
+    check_index(index, a, n);
+    speedup_index_i64_free(index);
+
+    speedup_set_numa_replication(0);
+    speedup_set_threads_hint(0);
+    free(keys);
+    free(out);
+    free(a);
+    return 0;
+}
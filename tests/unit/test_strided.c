@@ -0,0 +1,94 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "speedup/api.h"
+
+typedef int64_t (*strided_fn)(const void* base, size_t stride, size_t key_offset, int64_t key, int64_t size);
+
+/* Linear scan: first record whose key equals key. */
+static int64_t naive(const char* base, size_t stride, size_t offset, int64_t key, int64_t size) {
+    for (int64_t i = 0; i < size; i++) {
+        int64_t k;
+        memcpy(&k, base + (size_t)i * stride + offset, sizeof(k));
+        if (k == key) return i;
+        if (k > key) break;
+    }
+    return -1;
+}
+
+static int64_t naive_lower(const char* base, size_t stride, size_t offset, int64_t key, int64_t size) {
+    int64_t i = 0;
+    for (; i < size; i++) {
+        int64_t k;
+        memcpy(&k, base + (size_t)i * stride + offset, sizeof(k));
+        if (k >= key) break;
+    }
+    return i;
+}
+
+int main(void) {
+    speedup_init();
+    const strided_fn search[] = {
+        speedup_binary_search_i64_strided_ref,
+        speedup_binary_search_i64_strided_branchless,
+        speedup_binary_search_i64_strided,
+    };
+    /* Record sizes with the key first, last and misaligned. */
+    const size_t strides[] = {8, 16, 24, 64, 128};
+    const size_t sizes[] = {0, 1, 2, 3, 7, 64, 1000};
+    uint64_t rng = 7;
+
+    for (size_t s = 0; s < sizeof(strides) / sizeof(strides[0]); s++) {
+        size_t stride = strides[s];
+        size_t offsets[] = {0, stride - 8, stride > 8 ? 3 : 0};
+        for (size_t o = 0; o < 3; o++) {
+            size_t offset = offsets[o];
+            for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+                int64_t size = (int64_t)sizes[n];
+                char* records = (char*)malloc((size_t)(size + 1) * stride);
+                memset(records, 0xAB, (size_t)(size + 1) * stride);
+                /* Keys with gaps and runs of duplicates. */
+                int64_t v = -50;
+                for (int64_t i = 0; i < size; i++) {
+                    rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+                    v += (int64_t)((rng >> 33) % 3);
+                    memcpy(records + (size_t)i * stride + offset, &v, sizeof(v));
+                }
+                for (int64_t key = -52; key <= v + 2; key++) {
+                    int64_t want = naive(records, stride, offset, key, size);
+                    for (size_t f = 0; f < sizeof(search) / sizeof(search[0]); f++) {
+                        assert(search[f](records, stride, offset, key, size) == want);
+                    }
+                    assert(speedup_lower_bound_i64_strided(records, stride, offset, key, size) ==
+                           naive_lower(records, stride, offset, key, size));
+                }
+
+                /* Gathered keys and indexes built from the records agree with
+                 * the strided search. */
+                int64_t* keys = (int64_t*)malloc((size_t)(size + 1) * sizeof(int64_t));
+                speedup_keys_gather_i64(records, stride, offset, size, keys);
+                speedup_index_i64_t* stree =
+                    speedup_index_i64_build_records(SPEEDUP_INDEX_LAYOUT_STREE, records, stride, offset, size);
+                speedup_index_i64_t* eytzinger =
+                    speedup_index_i64_build_records(SPEEDUP_INDEX_LAYOUT_EYTZINGER, records, stride, offset, size);
+                assert(stree && eytzinger);
+                assert(speedup_index_i64_size(stree) == size);
+                for (int64_t i = 0; i < size; i++) {
+                    int64_t k;
+                    memcpy(&k, records + (size_t)i * stride + offset, sizeof(k));
+                    assert(keys[i] == k);
+                    int64_t first = naive(records, stride, offset, k, size);
+                    assert(speedup_index_i64_find(stree, k) == first);
+                    assert(speedup_index_i64_find(eytzinger, k) == first);
+                }
+                assert(speedup_index_i64_find(stree, v + 1) == -1);
+                speedup_index_i64_free(stree);
+                speedup_index_i64_free(eytzinger);
+                free(keys);
+                free(records);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "speedup/api.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef HANDLE test_thread_t;
+#define THREAD_FN(name) static DWORD WINAPI name(LPVOID arg)
+#define THREAD_RETURN return 0
+static void thread_start(test_thread_t* t, LPTHREAD_START_ROUTINE fn, void* arg) {
+    *t = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    assert(*t != NULL);
+}
+static void thread_join(test_thread_t t) {
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+#else
+#include <pthread.h>
+typedef pthread_t test_thread_t;
+#define THREAD_FN(name) static void* name(void* arg)
+#define THREAD_RETURN return NULL
+static void thread_start(test_thread_t* t, void* (*fn)(void*), void* arg) {
+    int rc = pthread_create(t, NULL, fn, arg);
+    assert(rc == 0);
+    (void)rc;
+}
+static void thread_join(test_thread_t t) { pthread_join(t, NULL); }
+#endif
+
+static const speedup_cache_hint_t g_hints[2] = {{1, 2, 3, 4}, {32768, 1048576, 33554432, 64}};
+static _Atomic int g_stop;
+
+/* Flips both hints while the main thread batches and reads them back. */
+THREAD_FN(hint_setter) {
+    (void)arg;
+    for (uint32_t i = 0; !atomic_load(&g_stop); i++) {
+        speedup_set_threads_hint(1 + i % 4);
+        speedup_set_cache_hint(g_hints[i % 2]);
+    }
+    THREAD_RETURN;
+}
+
+int main(void) {
+    const int64_t size = 1000003;
+    const int64_t n = 300000;
+    int64_t* a = (int64_t*)malloc(size * sizeof(int64_t));
+    int64_t* keys = (int64_t*)malloc(n * sizeof(int64_t));
+    int64_t* out = (int64_t*)malloc(n * sizeof(int64_t));
+    for (int64_t i = 0; i < size; i++) a[i] = i * 2;
+
+    srand(7);
+    for (int64_t i = 0; i < n; i++) keys[i] = ((int64_t)rand() * 7919) % (2 * size);
+
+    /* 0 is auto-detect; the other hints force 1, several and more workers
+     * than chunks per worker, and each change restarts the pool. */
+    uint32_t hints[] = {0, 1, 3, 8, 2};
+    for (int h = 0; h < (int)(sizeof(hints) / sizeof(hints[0])); h++) {
+        speedup_set_threads_hint(hints[h]);
+        assert(speedup_get_effective_threads() >= 1);
+        if (hints[h]) assert(speedup_get_effective_threads() == hints[h]);
+
+        for (int rep = 0; rep < 3; rep++) {
+            for (int64_t i = 0; i < n; i++) out[i] = -2;
+            speedup_binary_search_i64_batch(a, size, keys, n, out);
+            for (int64_t i = 0; i < n; i++) {
+                assert(out[i] == speedup_binary_search_i64_ref(a, keys[i], size));
+            }
+        }
+
+        /* Sorted input takes the merge path, split across the same pool. */
+        for (int64_t i = 0; i < n; i++) keys[i] = i * 5;
+        speedup_binary_search_i64_batch(a, size, keys, n, out);
+        for (int64_t i = 0; i < n; i++) {
+            assert(out[i] == speedup_binary_search_i64_ref(a, keys[i], size));
+        }
+        for (int64_t i = 0; i < n; i++) keys[i] = ((int64_t)rand() * 7919) % (2 * size);
+    }
+
+    /* Hints change under running batches; a cache hint read back is always
+     * one of the two written whole. */
+    speedup_cache_hint_t saved = speedup_get_cache_hint();
+    atomic_init(&g_stop, 0);
+    test_thread_t setter;
+    thread_start(&setter, hint_setter, NULL);
+    for (int rep = 0; rep < 20; rep++) {
+        speedup_binary_search_i64_batch(a, size, keys, n, out);
+        for (int64_t i = 0; i < n; i += 97) assert(out[i] == speedup_binary_search_i64_ref(a, keys[i], size));
+        for (int r = 0; r < 1000; r++) {
+            speedup_cache_hint_t hint = speedup_get_cache_hint();
+            assert(hint.l2_bytes == g_hints[hint.l1_bytes == g_hints[1].l1_bytes].l2_bytes);
+            assert(hint.cacheline_bytes == g_hints[hint.l1_bytes == g_hints[1].l1_bytes].cacheline_bytes);
+        }
+    }
+    atomic_store(&g_stop, 1);
+    thread_join(setter);
+    speedup_set_cache_hint(saved);
+    speedup_set_threads_hint(0);
+
+    free(a);
+    free(keys);
+    free(out);
+    return 0;
+}
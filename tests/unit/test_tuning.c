@@ -0,0 +1,185 @@
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "speedup/api.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef HANDLE test_thread_t;
+#define THREAD_FN(name) static DWORD WINAPI name(LPVOID arg)
+#define THREAD_RETURN return 0
+static void thread_start(test_thread_t* t, LPTHREAD_START_ROUTINE fn, void* arg) {
+    *t = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    assert(*t != NULL);
+}
+static void thread_join(test_thread_t t) {
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+#else
+#include <pthread.h>
+typedef pthread_t test_thread_t;
+#define THREAD_FN(name) static void* name(void* arg)
+#define THREAD_RETURN return NULL
+static void thread_start(test_thread_t* t, void* (*fn)(void*), void* arg) {
+    int rc = pthread_create(t, NULL, fn, arg);
+    assert(rc == 0);
+    (void)rc;
+}
+static void thread_join(test_thread_t t) { pthread_join(t, NULL); }
+#endif
+
+#define RELOADS 300
+
+static void check_search(void) {
+    int64_t sizes[] = {1, 5, 1000, 5000, 70000};
+    int64_t* a = (int64_t*)malloc(70000 * sizeof(int64_t));
+    for (int64_t i = 0; i < 70000; i++) a[i] = i * 2;
+    for (int s = 0; s < 5; s++) {
+        for (int64_t k = -1; k < 2 * sizes[s] + 1; k += 1 + sizes[s] / 50) {
+            assert(speedup_binary_search_i64(a, k, sizes[s]) == speedup_binary_search_i64_ref(a, k, sizes[s]));
+        }
+    }
+    free(a);
+}
+
+/* Every registered kernel agrees with the reference, on both sides of the
+ * AVX2 kernel's prefetch threshold and across its block clamping at the
+ * ends; the AVX2 kernel also returns the first of repeated keys. */
+static void check_kernels(void) {
+    int64_t sizes[] = {0, 1, 15, 16, 17, 100, 1000, 40000, 100003};
+    int64_t* a = (int64_t*)malloc(100003 * sizeof(int64_t));
+    int64_t* d = (int64_t*)malloc(100003 * sizeof(int64_t));
+    for (int64_t i = 0; i < 100003; i++) {
+        a[i] = i * 2;
+        d[i] = i / 3;
+    }
+    for (int s = 0; s < 9; s++) {
+        int64_t n = sizes[s];
+        for (int64_t k = -1; k < 2 * n + 1; k += 1 + n / 500) {
+            int64_t want = speedup_binary_search_i64_ref(a, k, n);
+            for (int i = 0; i < speedup_kernel_count(); i++) {
+                assert(speedup_kernel_get(i)->search_i64(a, k, n) == want);
+            }
+            int64_t first = (n > 0 && k >= 0 && k <= (n - 1) / 3) ? 3 * k : -1;
+            assert(speedup_binary_search_i64_avx2(d, k, n) == first);
+        }
+    }
+    free(a);
+    free(d);
+}
+
+static _Atomic int g_stop;
+
+/* Searches across every band of the profiles the main thread swaps in. */
+THREAD_FN(searcher) {
+    const int64_t* a = (const int64_t*)arg;
+    int64_t sizes[] = {10, 4000, 5000, 70000};
+    while (!atomic_load(&g_stop)) {
+        for (int s = 0; s < 4; s++) {
+            for (int64_t i = 0; i < sizes[s]; i += 1 + sizes[s] / 64) {
+                assert(speedup_binary_search_i64(a, 2 * i, sizes[s]) == i);
+                assert(speedup_binary_search_i64(a, 2 * i + 1, sizes[s]) == -1);
+            }
+        }
+    }
+    THREAD_RETURN;
+}
+
+/* Profiles with one, three and no bands replace each other while another
+ * thread searches. */
+static void check_concurrent_reload(const char* path) {
+    const char* one = "speedup_test_tuning_one.profile";
+    FILE* f = fopen(one, "w");
+    fprintf(f, "speedup-tuning 1\nmax branchless\n");
+    fclose(f);
+    f = fopen(path, "w");
+    fprintf(f, "speedup-tuning 1\n4096 branchless\n65536 ref\nmax branchless_prefetch\n");
+    fclose(f);
+
+    int64_t* a = (int64_t*)malloc(70000 * sizeof(int64_t));
+    for (int64_t i = 0; i < 70000; i++) a[i] = i * 2;
+    atomic_init(&g_stop, 0);
+    test_thread_t thread;
+    thread_start(&thread, searcher, a);
+    for (int r = 0; r < RELOADS; r++) {
+        if (r % 3 == 2) {
+            speedup_tuning_reset();
+        } else {
+            assert(speedup_tuning_load(r % 3 == 0 ? one : path) == 0);
+        }
+    }
+    atomic_store(&g_stop, 1);
+    thread_join(thread);
+    free(a);
+    remove(one);
+}
+
+int main(void) {
+    const char* path = "speedup_test_tuning.profile";
+    speedup_init();
+
+    assert(speedup_kernel_count() >= 1);
+    for (int i = 0; i < speedup_kernel_count(); i++) {
+        const speedup_kernel_info_t* k = speedup_kernel_get(i);
+        assert(speedup_kernel_find(k->name) == k);
+    }
+    assert(speedup_kernel_get(speedup_kernel_count()) == NULL);
+    assert(speedup_kernel_find("no_such_kernel") == NULL);
+    check_kernels();
+    const char* untuned = speedup_tuning_kernel_for_size(100);
+    assert(speedup_kernel_find(untuned) != NULL);
+
+    /* Hand-written profile: bands map sizes to the named kernels. */
+    FILE* f = fopen(path, "w");
+    fprintf(f, "speedup-tuning 1\n# comment\n4096 branchless\n65536 ref\nmax branchless_prefetch\n");
+    fclose(f);
+    assert(speedup_tuning_load(path) == 0);
+    assert(strcmp(speedup_tuning_kernel_for_size(10), "branchless") == 0);
+    assert(strcmp(speedup_tuning_kernel_for_size(4096), "branchless") == 0);
+    assert(strcmp(speedup_tuning_kernel_for_size(4097), "ref") == 0);
+    assert(strcmp(speedup_tuning_kernel_for_size(1 << 20), "branchless_prefetch") == 0);
+    check_search();
+
+    /* Calibrate, save, reset, reload: the same decisions come back. */
+    assert(speedup_calibrate(1 << 16) == 0);
+    const char* small = speedup_tuning_kernel_for_size(1000);
+    const char* large = speedup_tuning_kernel_for_size(1 << 16);
+    assert(speedup_tuning_save(path) == 0);
+    speedup_tuning_reset();
+    assert(strcmp(speedup_tuning_kernel_for_size(1000), untuned) == 0);
+    assert(speedup_tuning_load(path) == 0);
+    assert(strcmp(speedup_tuning_kernel_for_size(1000), small) == 0);
+    assert(strcmp(speedup_tuning_kernel_for_size(1 << 16), large) == 0);
+    check_search();
+
+    /* Unknown kernels and bad headers leave the active profile unchanged. */
+    f = fopen(path, "w");
+    fprintf(f, "speedup-tuning 1\nmax no_such_kernel\n");
+    fclose(f);
+    assert(speedup_tuning_load(path) == -1);
+    f = fopen(path, "w");
+    fprintf(f, "garbage\n");
+    fclose(f);
+    assert(speedup_tuning_load(path) == -1);
+    /* Truncated profiles (no "max" band), sizes with trailing junk and bands
+     * after "max" are rejected too. */
+    const char* bad[] = {"4096 branchless\n65536 ref\n", "4096abc branchless\nmax ref\n",
+                         "max ref\n4096 branchless\n", "99999999999999999999 ref\nmax ref\n"};
+    for (int b = 0; b < 4; b++) {
+        f = fopen(path, "w");
+        fprintf(f, "speedup-tuning 1\n%s", bad[b]);
+        fclose(f);
+        assert(speedup_tuning_load(path) == -1);
+    }
+    assert(strcmp(speedup_tuning_kernel_for_size(1000), small) == 0);
+
+    check_concurrent_reload(path);
+    remove(path);
+    speedup_tuning_reset();
+    check_search();
+    return 0;
+}
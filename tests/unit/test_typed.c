@@ -0,0 +1,82 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "speedup/api.h"
+
+/* Sorted arrays with runs of duplicates spread over the type's range (both
+ * ends included), probed with every element, its neighbours and the extremes.
+ * Each kernel must return the first match or -1. */
+#define TEST_TYPE(T, SFX, LO, HI)                                                   \
+    static int64_t first_##SFX(const T* a, int64_t size, T key) {                 \
+        for (int64_t i = 0; i < size; i++) {                                      \
+            if (a[i] == key) return i;                                            \
+            if (a[i] > key) break;                                                \
+        }                                                                         \
+        return -1;                                                                \
+    }                                                                             \
+    static void check_##SFX(const T* a, int64_t size, T key) {                    \
+        int64_t expected = first_##SFX(a, size, key);                             \
+        assert(speedup_binary_search_##SFX##_simd(a, key, size) == expected);     \
+        assert(SEARCH_##SFX(a, key, size) == expected);                           \
+        assert(BRANCHLESS_##SFX(a, key, size) == expected);                       \
+    }                                                                             \
+    static void test_##SFX(void) {                                                \
+        static const int64_t sizes[] = {0, 1, 2, 15, 16, 17, 31, 32, 33, 63, 64,  \
+                                        65, 100, 1000, 4097};                     \
+        T* a = (T*)malloc(4097 * sizeof(T));                                      \
+        for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {      \
+            int64_t size = sizes[s];                                              \
+            double step = ((double)(HI) - (double)(LO)) / (double)(size + 1);     \
+            for (int64_t i = 0; i < size; i++) {                                  \
+                a[i] = (T)((double)(LO) + step * (double)(i - i % 3));           \
+            }                                                                     \
+            if (size > 0) a[size - 1] = (T)(HI);                                  \
+            check_##SFX(a, size, (T)(LO));                                        \
+            check_##SFX(a, size, (T)(HI));                                        \
+            for (int64_t i = 0; i < size; i++) {                                  \
+                check_##SFX(a, size, a[i]);                                       \
+                if (a[i] != (T)(LO)) check_##SFX(a, size, (T)(a[i] - 1));        \
+                if (a[i] != (T)(HI)) check_##SFX(a, size, (T)(a[i] + 1));        \
+            }                                                                     \
+        }                                                                         \
+        free(a);                                                                  \
+    }
+
+#define SEARCH_i16 speedup_binary_search_i16
+#define SEARCH_u16 speedup_binary_search_u16
+#define SEARCH_i32 speedup_binary_search_i32
+#define SEARCH_u32 speedup_binary_search_u32
+/* speedup_binary_search_i64 may return any of several equal keys. */
+#define SEARCH_i64 speedup_binary_search_i64_simd
+#define SEARCH_u64 speedup_binary_search_u64
+#define SEARCH_f32 speedup_binary_search_f32
+#define SEARCH_f64 speedup_binary_search_f64
+#define BRANCHLESS_i16 speedup_binary_search_i16_branchless
+#define BRANCHLESS_u16 speedup_binary_search_u16_branchless
+#define BRANCHLESS_i32 speedup_binary_search_i32_branchless
+#define BRANCHLESS_u32 speedup_binary_search_u32_branchless
+#define BRANCHLESS_i64 speedup_binary_search_i64_branchless
+#define BRANCHLESS_u64 speedup_binary_search_u64_branchless
+#define BRANCHLESS_f32 speedup_binary_search_f32_branchless
+#define BRANCHLESS_f64 speedup_binary_search_f64_branchless
+
+TEST_TYPE(int16_t, i16, INT16_MIN, INT16_MAX)
+TEST_TYPE(uint16_t, u16, 0, UINT16_MAX)
+TEST_TYPE(int32_t, i32, INT32_MIN, INT32_MAX)
+TEST_TYPE(uint32_t, u32, 0, UINT32_MAX)
+TEST_TYPE(int64_t, i64, -4611686018427387904LL, 4611686018427387904LL)
+TEST_TYPE(uint64_t, u64, 0, 9223372036854775808ULL)
+TEST_TYPE(float, f32, -1e30f, 1e30f)
+TEST_TYPE(double, f64, -1e300, 1e300)
+
+int main(void) {
+    test_i16();
+    test_u16();
+    test_i32();
+    test_u32();
+    test_i64();
+    test_u64();
+    test_f32();
+    test_f64();
+    return 0;
+}